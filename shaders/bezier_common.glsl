@@ -0,0 +1,28 @@
+// spolecny kod shaderu, ShaderProgram ho vklada za #version (a #extension) kazdeho shaderu
+
+// smer svetla a zakladni barva plochy
+const vec3 lightDir = normalize(vec3(0.4, 1.0, 0.3));
+const vec3 surfaceColor = vec3(0.2, 0.6, 1.0);
+
+// kubicka bernsteinova baze v t
+vec4 bernstein(float t)
+{
+    float s = 1.0 - t;
+    return vec4(s * s * s, 3.0 * s * s * t, 3.0 * s * t * t, t * t * t);
+}
+
+// derivace kubicke bernsteinovy baze podle t
+vec4 bernsteinDerivative(float t)
+{
+    float s = 1.0 - t;
+    return vec4(-3.0 * s * s, 3.0 * s * s - 6.0 * s * t, 6.0 * s * t - 3.0 * t * t, 3.0 * t * t);
+}
+
+// oboustranne osvetleni, aby byla videt i spodni strana plochy
+// normala nemusi byt jednotkova, v degenerovanem bode (slity okraj) je nulova
+vec3 shadeSurface(vec3 normal)
+{
+    vec3 n = dot(normal, normal) > 0.0 ? normalize(normal) : vec3(0.0, 1.0, 0.0);
+    float diffuse = abs(dot(n, lightDir));
+    return surfaceColor * (0.25 + 0.75 * diffuse);
+}
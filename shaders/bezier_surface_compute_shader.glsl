@@ -0,0 +1,88 @@
+#version 430 core
+
+// jedno vlakno = jeden bod mrizky, y skupiny = index plochy
+layout(local_size_x = 64) in;
+
+// kontrolni site ploch, bod [i][j] plochy p je controlPoints[p * 16 + i * 4 + j] (w se nepouziva)
+layout(std430, binding = 0) readonly buffer ControlNets
+{
+    vec4 controlPoints[];
+};
+
+// vystup: pozice a normala kazdeho bodu (6 floatu), stejne rozlozeni jako sit plochy pocitana na CPU
+layout(std430, binding = 1) writeonly buffer SurfaceVertices
+{
+    float vertices[];
+};
+
+// argumenty pro glMultiDrawElementsIndirect, jeden prikaz na plochu
+struct DrawElementsCommand
+{
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+layout(std430, binding = 2) writeonly buffer DrawCommands
+{
+    DrawElementsCommand commands[];
+};
+
+// mrizka resolution x resolution bodu na plochu, indexCount indexu site jedne plochy
+uniform int resolution;
+uniform int indexCount;
+
+// baze bernstein a bernsteinDerivative je ve spolecnem kodu (bezier_common.glsl)
+void main()
+{
+    uint patchIndex = gl_WorkGroupID.y;
+    uint pointCount = uint(resolution * resolution);
+    uint k = gl_GlobalInvocationID.x;
+
+    if (k == 0u) {
+        commands[patchIndex] = DrawElementsCommand(uint(indexCount), 1u, 0u, int(patchIndex * pointCount), 0u);
+    }
+    if (k >= pointCount) {
+        return;
+    }
+
+    // stejne parametry jako bezierSampleParameter, oba okraje presne
+    float u = float(k / uint(resolution)) / float(resolution - 1);
+    float v = float(k % uint(resolution)) / float(resolution - 1);
+    vec4 Bu = bernstein(u);
+    vec4 Bv = bernstein(v);
+    vec4 dBu = bernsteinDerivative(u);
+    vec4 dBv = bernsteinDerivative(v);
+
+    uint first = patchIndex * 16u;
+    vec3 position = vec3(0.0);
+    vec3 du = vec3(0.0);
+    vec3 dv = vec3(0.0);
+    for (uint i = 0u; i < 4u; ++i) {
+        vec3 p0 = controlPoints[first + i * 4u].xyz;
+        vec3 p1 = controlPoints[first + i * 4u + 1u].xyz;
+        vec3 p2 = controlPoints[first + i * 4u + 2u].xyz;
+        vec3 p3 = controlPoints[first + i * 4u + 3u].xyz;
+        // radek site slozeny ve smeru v a jeho derivace podle v
+        vec3 row = Bv.x * p0 + Bv.y * p1 + Bv.z * p2 + Bv.w * p3;
+        vec3 rowDv = dBv.x * p0 + dBv.y * p1 + dBv.z * p2 + dBv.w * p3;
+        position += Bu[i] * row;
+        du += dBu[i] * row;
+        dv += Bu[i] * rowDv;
+    }
+
+    // stejne jako surfaceNormalFromPartials, v degenerovanem bode normala neexistuje
+    vec3 n = cross(du, dv);
+    float len = length(n);
+    n = len > 1e-12 ? n / len : vec3(0.0, 1.0, 0.0);
+
+    uint base = (patchIndex * pointCount + k) * 6u;
+    vertices[base] = position.x;
+    vertices[base + 1u] = position.y;
+    vertices[base + 2u] = position.z;
+    vertices[base + 3u] = n.x;
+    vertices[base + 4u] = n.y;
+    vertices[base + 5u] = n.z;
+}
@@ -0,0 +1,44 @@
+#version 330 core
+
+// parametry bodu mrizky, bod plochy se pocita az tady
+layout(location = 0) in vec2 uv;
+
+out vec3 fragColor;
+
+layout(std140) uniform CameraMatrices
+{
+    mat4 camMatrix;
+};
+uniform mat4 modelMatrix;
+
+// kontrolni body plochy, radek i je controlPoints[i * 4 .. i * 4 + 3] (w se nepouziva)
+layout(std140) uniform ControlPoints
+{
+    vec4 controlPoints[16];
+};
+
+// bernstein, bernsteinDerivative a shadeSurface jsou ve spolecnem kodu (bezier_common.glsl)
+void main()
+{
+    vec4 Bu = bernstein(uv.x);
+    vec4 Bv = bernstein(uv.y);
+    vec4 dBu = bernsteinDerivative(uv.x);
+    vec4 dBv = bernsteinDerivative(uv.y);
+
+    vec3 position = vec3(0.0);
+    vec3 du = vec3(0.0);
+    vec3 dv = vec3(0.0);
+    for (int i = 0; i < 4; ++i) {
+        // radek site slozeny ve smeru v a jeho derivace podle v
+        vec3 row = Bv.x * controlPoints[i * 4].xyz + Bv.y * controlPoints[i * 4 + 1].xyz
+                 + Bv.z * controlPoints[i * 4 + 2].xyz + Bv.w * controlPoints[i * 4 + 3].xyz;
+        vec3 rowDv = dBv.x * controlPoints[i * 4].xyz + dBv.y * controlPoints[i * 4 + 1].xyz
+                   + dBv.z * controlPoints[i * 4 + 2].xyz + dBv.w * controlPoints[i * 4 + 3].xyz;
+        position += Bu[i] * row;
+        du += dBu[i] * row;
+        dv += Bu[i] * rowDv;
+    }
+
+    gl_Position = camMatrix * modelMatrix * vec4(position, 1.0);
+    fragColor = shadeSurface(mat3(modelMatrix) * cross(du, dv));
+}
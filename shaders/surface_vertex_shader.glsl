@@ -0,0 +1,19 @@
+#version 330 core
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+
+out vec3 fragColor;
+
+layout(std140) uniform CameraMatrices
+{
+    mat4 camMatrix;
+};
+uniform mat4 modelMatrix;
+
+// osvetleni shadeSurface je ve spolecnem kodu (bezier_common.glsl)
+void main()
+{
+    gl_Position = camMatrix * modelMatrix * vec4(position, 1.0);
+    fragColor = shadeSurface(mat3(modelMatrix) * normal);
+}
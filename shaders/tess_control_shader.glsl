@@ -0,0 +1,48 @@
+#version 330 core
+#extension GL_ARB_tessellation_shader : require
+
+// 16 kontrolnich bodu plochy, bod [i][j] je na indexu i * 4 + j
+layout(vertices = 16) out;
+
+layout(std140) uniform CameraMatrices
+{
+    mat4 camMatrix;
+};
+uniform mat4 modelMatrix;
+// velikost okna v pixelech a cilova delka jednoho useku site v pixelech
+uniform vec2 viewportSize;
+uniform float pixelsPerSegment;
+
+vec2 toScreen(int k)
+{
+    vec4 clip = camMatrix * modelMatrix * gl_in[k].gl_Position;
+    // body za kamerou by mely w <= 0
+    return clip.xy / max(clip.w, 1e-4) * 0.5 * viewportSize;
+}
+
+// uroven deleni hrany podle delky jejiho kontrolniho polygonu na obrazovce (horni odhad delky hrany)
+float edgeLevel(int a, int b, int c, int d)
+{
+    vec2 pa = toScreen(a);
+    vec2 pb = toScreen(b);
+    vec2 pc = toScreen(c);
+    vec2 pd = toScreen(d);
+    float polygonLength = distance(pa, pb) + distance(pb, pc) + distance(pc, pd);
+    return clamp(polygonLength / pixelsPerSegment, 1.0, float(gl_MaxTessGenLevel));
+}
+
+void main()
+{
+    gl_out[gl_InvocationID].gl_Position = gl_in[gl_InvocationID].gl_Position;
+
+    if (gl_InvocationID == 0) {
+        // hrany u = 0, v = 0, u = 1, v = 1 (poradi vnejsich urovni pro quads)
+        // uroven hrany zavisi jen na jejich bodech, takze sousedni plochy na sebe navazuji bez der
+        gl_TessLevelOuter[0] = edgeLevel(0, 1, 2, 3);
+        gl_TessLevelOuter[1] = edgeLevel(0, 4, 8, 12);
+        gl_TessLevelOuter[2] = edgeLevel(12, 13, 14, 15);
+        gl_TessLevelOuter[3] = edgeLevel(3, 7, 11, 15);
+        gl_TessLevelInner[0] = max(gl_TessLevelOuter[1], gl_TessLevelOuter[3]);
+        gl_TessLevelInner[1] = max(gl_TessLevelOuter[0], gl_TessLevelOuter[2]);
+    }
+}
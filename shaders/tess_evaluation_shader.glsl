@@ -0,0 +1,38 @@
+#version 330 core
+#extension GL_ARB_tessellation_shader : require
+
+layout(quads, equal_spacing, ccw) in;
+
+out vec3 fragColor;
+
+layout(std140) uniform CameraMatrices
+{
+    mat4 camMatrix;
+};
+uniform mat4 modelMatrix;
+
+// bernstein, bernsteinDerivative a shadeSurface jsou ve spolecnem kodu (bezier_common.glsl)
+void main()
+{
+    // u ve smeru radku site, v ve smeru sloupcu
+    vec4 Bu = bernstein(gl_TessCoord.x);
+    vec4 Bv = bernstein(gl_TessCoord.y);
+    vec4 dBu = bernsteinDerivative(gl_TessCoord.x);
+    vec4 dBv = bernsteinDerivative(gl_TessCoord.y);
+
+    vec3 position = vec3(0.0);
+    vec3 du = vec3(0.0);
+    vec3 dv = vec3(0.0);
+    for (int i = 0; i < 4; ++i) {
+        vec3 row = Bv.x * gl_in[i * 4].gl_Position.xyz + Bv.y * gl_in[i * 4 + 1].gl_Position.xyz
+                 + Bv.z * gl_in[i * 4 + 2].gl_Position.xyz + Bv.w * gl_in[i * 4 + 3].gl_Position.xyz;
+        vec3 rowDv = dBv.x * gl_in[i * 4].gl_Position.xyz + dBv.y * gl_in[i * 4 + 1].gl_Position.xyz
+                   + dBv.z * gl_in[i * 4 + 2].gl_Position.xyz + dBv.w * gl_in[i * 4 + 3].gl_Position.xyz;
+        position += Bu[i] * row;
+        du += dBu[i] * row;
+        dv += Bu[i] * rowDv;
+    }
+
+    gl_Position = camMatrix * modelMatrix * vec4(position, 1.0);
+    fragColor = shadeSurface(mat3(modelMatrix) * cross(du, dv));
+}
@@ -0,0 +1,9 @@
+#version 330 core
+
+// kontrolni bod plochy, transformace se dela az v evaluacnim shaderu
+layout(location = 0) in vec3 position;
+
+void main()
+{
+    gl_Position = vec4(position, 1.0);
+}
@@ -2,14 +2,21 @@
 
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 color;
+// posun (xyz) a meritko (w) instance, bez instanci ma atribut hodnotu (0, 0, 0, 1)
+layout(location = 2) in vec4 instanceOffsetScale;
 
 out vec3 fragColor;
 
-uniform mat4 camMatrix;
+// matice kamery ze sdileneho uniform bufferu (zapisuje ji Camera::UpdateMatrix)
+layout(std140) uniform CameraMatrices
+{
+    mat4 camMatrix;
+};
 uniform mat4 modelMatrix;
 
 void main()
 {
-    gl_Position = camMatrix * modelMatrix * vec4(position, 1.0);
+    vec3 instancePosition = position * instanceOffsetScale.w + instanceOffsetScale.xyz;
+    gl_Position = camMatrix * modelMatrix * vec4(instancePosition, 1.0);
     fragColor = color;
 }
@@ -0,0 +1,125 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+#include "bezierTemplate.h"
+
+/*
+ sdilene tabulky bernsteinovy baze podle (stupen, pocet bodu)
+ - parametry bodu jsou t_k = k / (sampleCount - 1), takze tabulka obsahuje oba okraje presne
+ - tabulka se spocita jen jednou a pak se pouziva pri kazdem dalsim vypoctu krivky i plochy,
+   vypocet bodu je tak jen nasobeni a scitani s predpocitanymi vahami
+ - tabulka zacina na hranici 32 bajtu a radky jsou doplnene na nasobek 4 floatu, kazdy radek je tedy zarovnany
+   na 16 bajtu (staci pro SSE), AVX nacitani radku musi byt nezarovnane (_mm256_loadu_ps)
+*/
+
+// alokator zarovnany na Alignment bajtu
+template<typename T, std::size_t Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, std::size_t)
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+struct BernsteinBasisTable
+{
+    int degree = 0;
+    int sampleCount = 0;
+    // pocet floatu na radek (degree + 1 zaokrouhleno nahoru na nasobek 4)
+    int stride = 0;
+    std::vector<float, AlignedAllocator<float, 32>> weights;
+    std::vector<float, AlignedAllocator<float, 32>> derivatives;
+
+    // vahy B_0..B_degree v parametru t_k
+    const float* row(int k) const { return &weights[k * stride]; }
+    // derivace vah podle t v parametru t_k
+    const float* derivativeRow(int k) const { return &derivatives[k * stride]; }
+};
+
+BernsteinBasisTable makeBernsteinBasisTable(int degree, int sampleCount)
+{
+    BernsteinBasisTable table;
+    table.degree = degree;
+    table.sampleCount = sampleCount;
+    table.stride = (degree + 1 + 3) & ~3;
+    table.weights.assign(static_cast<size_t>(sampleCount) * table.stride, 0.0f);
+    table.derivatives.assign(static_cast<size_t>(sampleCount) * table.stride, 0.0f);
+
+    for (int k = 0; k < sampleCount; ++k) {
+        float t = bezierSampleParameter(k, sampleCount);
+        float s = 1.0f - t;
+        float* w = &table.weights[k * table.stride];
+        // stejne poradi nasobeni jako bezierCurve, aby byly body bitove shodne
+        for (int i = 0; i <= degree; ++i) {
+            float b = static_cast<float>(binomial(degree, i));
+            for (int e = 0; e < degree - i; ++e) {
+                b *= s;
+            }
+            for (int e = 0; e < i; ++e) {
+                b *= t;
+            }
+            w[i] = b;
+        }
+
+        // B'_i,n = n * (B_i-1,n-1 - B_i,n-1)
+        float* d = &table.derivatives[k * table.stride];
+        for (int i = 0; i <= degree; ++i) {
+            float lower = 0.0f;
+            float same = 0.0f;
+            if (i >= 1) {
+                lower = static_cast<float>(binomial(degree - 1, i - 1)) * std::pow(s, degree - i) * std::pow(t, i - 1);
+            }
+            if (i <= degree - 1) {
+                same = static_cast<float>(binomial(degree - 1, i)) * std::pow(s, degree - 1 - i) * std::pow(t, i);
+            }
+            d[i] = degree * (lower - same);
+        }
+    }
+    return table;
+}
+
+// tabulka z cache, pri prvnim pozadavku se spocita; odkaz zustava platny po celou dobu behu
+const BernsteinBasisTable& bernsteinBasisTable(int degree, int sampleCount)
+{
+    static std::map<std::pair<int, int>, BernsteinBasisTable> tables;
+    static std::mutex tablesMutex;
+
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    auto key = std::make_pair(degree, sampleCount);
+    auto it = tables.find(key);
+    if (it == tables.end()) {
+        it = tables.emplace(key, makeBernsteinBasisTable(degree, sampleCount)).first;
+    }
+    return it->second;
+}
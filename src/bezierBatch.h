@@ -0,0 +1,194 @@
+#pragma once
+#include "glm.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BEZIER_BATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+/*
+ davkove vyhodnoceni kubicke bezierovy krivky pro vice parametru t najednou
+ - SSE2 pocita 4 hodnoty t na instrukci, AVX2 8 hodnot
+ - vsechny varianty pocitaji ve stejnem poradi operaci jako bezierCurve (bez FMA),
+   takze vysledky jsou bitove shodne se skalarni verzi
+ - vystup je bud SoA (pole x a pole y) nebo prokladany (glm::vec3, z = 0)
+*/
+
+// SSE2 neni na i386 vychozi, jadra se prekladaji pro svou instrukcni sadu a vybiraji se za behu
+#if defined(BEZIER_BATCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BEZIER_TARGET_SSE2 __attribute__((target("sse2")))
+#define BEZIER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define BEZIER_TARGET_SSE2
+#define BEZIER_TARGET_AVX2
+#endif
+
+enum class SimdLevel
+{
+    Scalar = 0,
+    SSE2 = 1,
+    AVX2 = 2
+};
+
+const char* simdLevelName(SimdLevel level)
+{
+    switch (level) {
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "Scalar";
+    }
+}
+
+// zjisti za behu, jake instrukce procesor podporuje
+SimdLevel detectSimdLevel()
+{
+#if defined(BEZIER_BATCH_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SimdLevel::SSE2;
+    }
+#elif defined(BEZIER_BATCH_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuidex(info, 1, 0);
+        bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 0x6) == 0x6);
+        __cpuidex(info, 7, 0);
+        if (osSavesAvx && (info[1] & (1 << 5))) {
+            return SimdLevel::AVX2;
+        }
+    }
+    return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+// skalarni varianta, stejne poradi operaci jako bezierCurve
+void bezierCurveBatchScalar(const glm::vec3& P0, const glm::vec3& P1, const glm::vec3& P2, const glm::vec3& P3,
+                            const float* t, int count, float* outX, float* outY)
+{
+    for (int i = 0; i < count; ++i) {
+        float s = 1.0f - t[i];
+        float b03 = s * s * s;
+        float b13 = 3.0f * s * s * t[i];
+        float b23 = 3.0f * s * t[i] * t[i];
+        float b33 = t[i] * t[i] * t[i];
+        outX[i] = b03 * P0.x + b13 * P1.x + b23 * P2.x + b33 * P3.x;
+        outY[i] = b03 * P0.y + b13 * P1.y + b23 * P2.y + b33 * P3.y;
+    }
+}
+
+#if defined(BEZIER_BATCH_X86)
+// SSE2 varianta, 4 hodnoty t najednou
+BEZIER_TARGET_SSE2
+void bezierCurveBatchSse(const glm::vec3& P0, const glm::vec3& P1, const glm::vec3& P2, const glm::vec3& P3,
+                         const float* t, int count, float* outX, float* outY)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 three = _mm_set1_ps(3.0f);
+    const __m128 p0x = _mm_set1_ps(P0.x), p1x = _mm_set1_ps(P1.x), p2x = _mm_set1_ps(P2.x), p3x = _mm_set1_ps(P3.x);
+    const __m128 p0y = _mm_set1_ps(P0.y), p1y = _mm_set1_ps(P1.y), p2y = _mm_set1_ps(P2.y), p3y = _mm_set1_ps(P3.y);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 tt = _mm_loadu_ps(t + i);
+        __m128 s = _mm_sub_ps(one, tt);
+        __m128 b03 = _mm_mul_ps(_mm_mul_ps(s, s), s);
+        __m128 b13 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(three, s), s), tt);
+        __m128 b23 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(three, s), tt), tt);
+        __m128 b33 = _mm_mul_ps(_mm_mul_ps(tt, tt), tt);
+
+        __m128 x = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b03, p0x), _mm_mul_ps(b13, p1x)),
+                                         _mm_mul_ps(b23, p2x)), _mm_mul_ps(b33, p3x));
+        __m128 y = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b03, p0y), _mm_mul_ps(b13, p1y)),
+                                         _mm_mul_ps(b23, p2y)), _mm_mul_ps(b33, p3y));
+        _mm_storeu_ps(outX + i, x);
+        _mm_storeu_ps(outY + i, y);
+    }
+    // zbytek, ktery se nevejde do 4
+    bezierCurveBatchScalar(P0, P1, P2, P3, t + i, count - i, outX + i, outY + i);
+}
+
+// AVX2 varianta, 8 hodnot t najednou
+BEZIER_TARGET_AVX2
+void bezierCurveBatchAvx2(const glm::vec3& P0, const glm::vec3& P1, const glm::vec3& P2, const glm::vec3& P3,
+                          const float* t, int count, float* outX, float* outY)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 three = _mm256_set1_ps(3.0f);
+    const __m256 p0x = _mm256_set1_ps(P0.x), p1x = _mm256_set1_ps(P1.x), p2x = _mm256_set1_ps(P2.x), p3x = _mm256_set1_ps(P3.x);
+    const __m256 p0y = _mm256_set1_ps(P0.y), p1y = _mm256_set1_ps(P1.y), p2y = _mm256_set1_ps(P2.y), p3y = _mm256_set1_ps(P3.y);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 tt = _mm256_loadu_ps(t + i);
+        __m256 s = _mm256_sub_ps(one, tt);
+        __m256 b03 = _mm256_mul_ps(_mm256_mul_ps(s, s), s);
+        __m256 b13 = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(three, s), s), tt);
+        __m256 b23 = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(three, s), tt), tt);
+        __m256 b33 = _mm256_mul_ps(_mm256_mul_ps(tt, tt), tt);
+
+        __m256 x = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(b03, p0x), _mm256_mul_ps(b13, p1x)),
+                                               _mm256_mul_ps(b23, p2x)), _mm256_mul_ps(b33, p3x));
+        __m256 y = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(b03, p0y), _mm256_mul_ps(b13, p1y)),
+                                               _mm256_mul_ps(b23, p2y)), _mm256_mul_ps(b33, p3y));
+        _mm256_storeu_ps(outX + i, x);
+        _mm256_storeu_ps(outY + i, y);
+    }
+    bezierCurveBatchSse(P0, P1, P2, P3, t + i, count - i, outX + i, outY + i);
+}
+#endif
+
+typedef void (*BezierCurveBatchFn)(const glm::vec3&, const glm::vec3&, const glm::vec3&, const glm::vec3&,
+                                   const float*, int, float*, float*);
+
+BezierCurveBatchFn bezierCurveBatchFor(SimdLevel level)
+{
+#if defined(BEZIER_BATCH_X86)
+    switch (level) {
+        case SimdLevel::AVX2: return bezierCurveBatchAvx2;
+        case SimdLevel::SSE2: return bezierCurveBatchSse;
+        default: break;
+    }
+#endif
+    return bezierCurveBatchScalar;
+}
+
+// aktualne pouzivana uroven (vybrana jednou pri prvnim volani, lze ji snizit pro porovnani)
+SimdLevel& bezierCurveBatchLevel()
+{
+    static SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+// vypocet bodu krivky pro pole parametru t, vystup jako pole x a pole y (SoA)
+void bezierCurveBatch(const glm::vec3& P0, const glm::vec3& P1, const glm::vec3& P2, const glm::vec3& P3,
+                      const float* t, int count, float* outX, float* outY)
+{
+    bezierCurveBatchFor(bezierCurveBatchLevel())(P0, P1, P2, P3, t, count, outX, outY);
+}
+
+// vypocet bodu krivky pro pole parametru t, vystup prokladany jako glm::vec3 (z je ve 2D = 0.0f)
+void bezierCurveBatchInterleaved(const glm::vec3& P0, const glm::vec3& P1, const glm::vec3& P2, const glm::vec3& P3,
+                                 const float* t, int count, glm::vec3* out)
+{
+    // po blocich pres zasobnik, aby se nic nealokovalo
+    const int chunk = 256;
+    float x[chunk];
+    float y[chunk];
+    BezierCurveBatchFn fn = bezierCurveBatchFor(bezierCurveBatchLevel());
+    for (int first = 0; first < count; first += chunk) {
+        int n = count - first < chunk ? count - first : chunk;
+        fn(P0, P1, P2, P3, t + first, n, x, y);
+        for (int i = 0; i < n; ++i) {
+            out[first + i] = glm::vec3(x[i], y[i], 0.0f);
+        }
+    }
+}
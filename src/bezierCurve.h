@@ -9,6 +9,13 @@
 #include "gtc/matrix_transform.hpp"
 #include "gtc/type_ptr.hpp"
 #include <vector>
+#include <algorithm>
+#include "bezierBatch.h"
+#include "basisCache.h"
+#include "streamBuffer.h"
+#include "shaderProgram.h"
+#include "gpuProfiler.h"
+#include "cpuProfiler.h"
 
 // vypocet bezierovy krivky pro body P0 az P3 s krokem t
 glm::vec3 bezierCurve(const glm::vec3& P0, const glm::vec3& P1, const glm::vec3& P2, const glm::vec3& P3, float t) 
@@ -26,141 +33,315 @@ glm::vec3 bezierCurve(const glm::vec3& P0, const glm::vec3& P1, const glm::vec3&
     return p;
 }
 
-// vypocitava body krivky pomoci bernsteinova polynomu pri kroku t
-void calculateBezierCurvePoints(const glm::vec3 controlPoints[4], float step, std::vector<glm::vec3>& curvePoints) 
+// zpusob vyhodnoceni bodu krivky (pro porovnani presnosti a rychlosti)
+enum class CurveEvaluator
+{
+    Bernstein = 0,
+    ForwardDifference = 1,
+    SimdBatch = 2,
+    Adaptive = 3
+};
+
+// vypocita dopredne diference krivky v parametru t pro krok h (hodnota, 1., 2. a 3. diference)
+void forwardDifferencesAt(const glm::vec3 controlPoints[4], float t, float h,
+                          glm::vec3& f, glm::vec3& df, glm::vec3& ddf, glm::vec3& dddf)
+{
+    // koeficienty polynomu a*t^3 + b*t^2 + c*t + d
+    glm::vec3 a = -controlPoints[0] + 3.0f * controlPoints[1] - 3.0f * controlPoints[2] + controlPoints[3];
+    glm::vec3 b = 3.0f * controlPoints[0] - 6.0f * controlPoints[1] + 3.0f * controlPoints[2];
+    glm::vec3 c = 3.0f * (controlPoints[1] - controlPoints[0]);
+    glm::vec3 d = controlPoints[0];
+
+    float h2 = h * h;
+    float h3 = h2 * h;
+    f = ((a * t + b) * t + c) * t + d;
+    df = a * (3.0f * t * t * h + 3.0f * t * h2 + h3) + b * (2.0f * t * h + h2) + c * h;
+    ddf = a * (6.0f * h2 * (t + h)) + b * (2.0f * h2);
+    dddf = a * (6.0f * h3);
+}
+
+// body krivky [first, last) doprednymi diferencemi (3 scitani vektoru na bod)
+// reanchorInterval > 0 po tolika bodech prepocita diference presne, aby se neakumulovala chyba floatu
+void evaluateBezierCurveSamplesForwardDiff(const glm::vec3 controlPoints[4], int sampleCount, int first, int last,
+                                           glm::vec3* out, int reanchorInterval)
+{
+    // stejny krok jako u bernsteinovy varianty, posledni bod lezi presne v t = 1
+    float h = 1.0f / (sampleCount - 1);
+
+    // hranice useku jsou nasobky reanchorInterval, takze nezavisi na tom, jak volajici rozdeli indexy
+    for (int begin = first; begin < last;) {
+        int end = reanchorInterval > 0 ? std::min(last, (begin / reanchorInterval + 1) * reanchorInterval) : last;
+        glm::vec3 anchorF, anchorDf, anchorDdf, anchorDddf;
+        forwardDifferencesAt(controlPoints, bezierSampleParameter(begin, sampleCount), h, anchorF, anchorDf, anchorDdf, anchorDddf);
+
+        // lokalni kopie, aby je prekladac drzel v registrech a ne v pameti
+        glm::vec3 f = anchorF, df = anchorDf, ddf = anchorDdf;
+        const glm::vec3 dddf = anchorDddf;
+        for (int i = begin; i < end; ++i) {
+            // z je ve 2D = 0.0f
+            out[i - first] = glm::vec3(f.x, f.y, 0.0f);
+            f += df;
+            df += ddf;
+            ddf += dddf;
+        }
+        begin = end;
+    }
+}
+
+// body krivky [first, last) davkove (SSE/AVX2), body jsou bitove shodne s bezierCurve
+void evaluateBezierCurveSamplesBatch(const glm::vec3 controlPoints[4], int sampleCount, int first, int last, glm::vec3* out)
+{
+    const int chunk = 256;
+    float params[chunk];
+
+    for (int begin = first; begin < last; begin += chunk) {
+        int n = std::min(chunk, last - begin);
+        for (int i = 0; i < n; ++i) {
+            params[i] = bezierSampleParameter(begin + i, sampleCount);
+        }
+        bezierCurveBatchInterleaved(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3],
+                                    params, n, out + (begin - first));
+    }
+}
+
+// body krivky [first, last) s vahami z tabulky baze, stejne poradi operaci jako bezierCurve
+void evaluateBezierCurveSamplesBernstein(const glm::vec3 controlPoints[4], const BernsteinBasisTable& basis,
+                                         int first, int last, glm::vec3* out)
+{
+    const glm::vec3& P0 = controlPoints[0];
+    const glm::vec3& P1 = controlPoints[1];
+    const glm::vec3& P2 = controlPoints[2];
+    const glm::vec3& P3 = controlPoints[3];
+    for (int k = first; k < last; ++k) {
+        const float* b = basis.row(k);
+        // z je ve 2D = 0.0f
+        out[k - first] = glm::vec3(b[0] * P0.x + b[1] * P1.x + b[2] * P2.x + b[3] * P3.x,
+                                   b[0] * P0.y + b[1] * P1.y + b[2] * P2.y + b[3] * P3.y, 0.0f);
+    }
+}
+
+// body krivky s indexy [first, last) ze sampleCount bodu (t_k = k / (sampleCount - 1), oba okraje presne)
+// zapisuje do out[0 .. last - first), nic nealokuje (krome prvniho vytvoreni sdilene tabulky baze),
+// takze lze usek indexu pocitat nezavisle, napr. v jinem vlakne nebo primo do namapovaneho bufferu
+// adaptivni vyhodnoceni nema pevny pocet bodu, pocita se jako Bernstein
+void evaluateBezierCurveSamples(const glm::vec3 controlPoints[4], int sampleCount, int first, int last, glm::vec3* out,
+                                CurveEvaluator evaluator = CurveEvaluator::Bernstein, int reanchorInterval = 0)
+{
+    if (evaluator == CurveEvaluator::ForwardDifference) {
+        evaluateBezierCurveSamplesForwardDiff(controlPoints, sampleCount, first, last, out, reanchorInterval);
+        return;
+    }
+    if (evaluator == CurveEvaluator::SimdBatch) {
+        evaluateBezierCurveSamplesBatch(controlPoints, sampleCount, first, last, out);
+        return;
+    }
+    evaluateBezierCurveSamplesBernstein(controlPoints, bernsteinBasisTable(3, sampleCount), first, last, out);
+}
+
+// prevod tolerance v pixelech na toleranci ve svetovych souradnicich podle matice kamery
+// (pro 2D ortograficke zobrazeni presne, pro perspektivu jen odhad v rovine z = 0)
+float pixelToleranceToWorld(const glm::mat4& camMatrix, int viewportWidth, int viewportHeight, float pixels)
+{
+    // kolik pixelu odpovida jednotce ve smeru osy x a y sveta
+    float pxPerUnitX = glm::length(glm::vec2(camMatrix[0][0] * viewportWidth, camMatrix[0][1] * viewportHeight)) * 0.5f;
+    float pxPerUnitY = glm::length(glm::vec2(camMatrix[1][0] * viewportWidth, camMatrix[1][1] * viewportHeight)) * 0.5f;
+    float pxPerUnit = std::max(pxPerUnitX, pxPerUnitY);
+    if (pxPerUnit <= 0.0f) {
+        return pixels;
+    }
+    return pixels / pxPerUnit;
+}
+
+// rekurzivni deleni krivky de Casteljauovym algoritmem, dokud neni usek dost plochy
+// do curvePoints pridava koncove body useku (pocatecni bod prida volajici)
+void flattenBezierCurve(const glm::vec3& P0, const glm::vec3& P1, const glm::vec3& P2, const glm::vec3& P3,
+                        float tolerance, std::vector<glm::vec3>& curvePoints, int depth = 0)
+{
+    // horni odhad vzdalenosti krivky od usecky P0P3 je sqrt(d) / 4
+    glm::vec3 a = 3.0f * P1 - 2.0f * P0 - P3;
+    glm::vec3 b = 3.0f * P2 - P0 - 2.0f * P3;
+    float d = std::max(a.x * a.x, b.x * b.x) + std::max(a.y * a.y, b.y * b.y);
+    const int maxDepth = 16;
+    if (depth >= maxDepth || d <= 16.0f * tolerance * tolerance) {
+        // z je ve 2D = 0.0f
+        curvePoints.push_back(glm::vec3(P3.x, P3.y, 0.0f));
+        return;
+    }
+
+    // rozdeleni v t = 0.5
+    glm::vec3 p01 = (P0 + P1) * 0.5f;
+    glm::vec3 p12 = (P1 + P2) * 0.5f;
+    glm::vec3 p23 = (P2 + P3) * 0.5f;
+    glm::vec3 p012 = (p01 + p12) * 0.5f;
+    glm::vec3 p123 = (p12 + p23) * 0.5f;
+    glm::vec3 mid = (p012 + p123) * 0.5f;
+    flattenBezierCurve(P0, p01, p012, mid, tolerance, curvePoints, depth + 1);
+    flattenBezierCurve(mid, p123, p23, P3, tolerance, curvePoints, depth + 1);
+}
+
+// adaptivni vypocet bodu krivky, tolerance je maximalni odchylka lomene cary od krivky
+void calculateBezierCurvePointsAdaptive(const glm::vec3 controlPoints[4], float tolerance, std::vector<glm::vec3>& curvePoints)
 {
     curvePoints.clear();
-    for (float t = 0.0f; t <= 1.0f; t += step) {
-        curvePoints.push_back(bezierCurve(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3], t));
+    curvePoints.push_back(glm::vec3(controlPoints[0].x, controlPoints[0].y, 0.0f));
+    flattenBezierCurve(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3], tolerance, curvePoints);
+}
+
+// vypocitava body krivky pomoci bernsteinova polynomu pri kroku t (pocet bodu viz bezierSampleCount)
+void calculateBezierCurvePoints(const glm::vec3 controlPoints[4], float step, std::vector<glm::vec3>& curvePoints,
+                                CurveEvaluator evaluator = CurveEvaluator::Bernstein, int reanchorInterval = 0,
+                                float tolerance = 0.0f) 
+{
+    CPU_ZONE("calculateBezierCurvePoints");
+    if (evaluator == CurveEvaluator::Adaptive && tolerance > 0.0f) {
+        calculateBezierCurvePointsAdaptive(controlPoints, tolerance, curvePoints);
+        return;
+    }
+    int count = bezierSampleCount(step);
+    curvePoints.resize(count);
+    evaluateBezierCurveSamples(controlPoints, count, 0, count, curvePoints.data(), evaluator, reanchorInterval);
+}
+
+// ulozene vstupy posledniho vypoctu krivky, aby se krivka neprepocitavala kazdy snimek
+// body se pocitaji az pri nahrani primo do namapovaneho bufferu (viz writeCurveCachePoints)
+struct CurveCache
+{
+    bool valid = false;
+    glm::vec3 controlPoints[4];
+    float step = 0.0f;
+    CurveEvaluator evaluator = CurveEvaluator::Bernstein;
+    int reanchorInterval = 0;
+    float tolerance = 0.0f;
+    int pointCount = 0;
+    // body adaptivniho deleni (jejich pocet neni predem znamy), ostatni zpusoby ho nepouzivaji
+    std::vector<glm::vec3> curvePoints;
+    // obsah VBO neodpovida krivce a controlPoints
+    bool gpuDirty = true;
+};
+
+bool curveCacheIsAdaptive(const CurveCache& cache)
+{
+    return cache.evaluator == CurveEvaluator::Adaptive && cache.tolerance > 0.0f;
+}
+
+// zaznamena zmenu vstupu krivky, vraci true pri zmene
+bool updateCurveCache(CurveCache& cache, const glm::vec3 controlPoints[4], float step,
+                      CurveEvaluator evaluator = CurveEvaluator::Bernstein, int reanchorInterval = 0,
+                      float tolerance = 0.0f)
+{
+    if (cache.valid && cache.step == step && cache.evaluator == evaluator &&
+        cache.reanchorInterval == reanchorInterval && cache.tolerance == tolerance &&
+        std::equal(controlPoints, controlPoints + 4, cache.controlPoints)) {
+        return false;
+    }
+
+    std::copy(controlPoints, controlPoints + 4, cache.controlPoints);
+    cache.step = step;
+    cache.evaluator = evaluator;
+    cache.reanchorInterval = reanchorInterval;
+    cache.tolerance = tolerance;
+    if (curveCacheIsAdaptive(cache)) {
+        calculateBezierCurvePointsAdaptive(controlPoints, tolerance, cache.curvePoints);
+        cache.pointCount = cache.curvePoints.size();
+    } else {
+        cache.pointCount = bezierSampleCount(step);
     }
+    cache.valid = true;
+    cache.gpuDirty = true;
+    return true;
 }
 
-std::vector<unsigned int> handlePointsIntoBuffers(glm::vec3 controlPoints[4])
+// zapise cache.pointCount bodu krivky do out (napr. primo do namapovaneho bufferu)
+void writeCurveCachePoints(const CurveCache& cache, glm::vec3* out)
+{
+    CPU_ZONE("writeCurveCachePoints");
+    if (curveCacheIsAdaptive(cache)) {
+        std::copy(cache.curvePoints.begin(), cache.curvePoints.end(), out);
+        return;
+    }
+    evaluateBezierCurveSamples(cache.controlPoints, cache.pointCount, 0, cache.pointCount, out,
+                               cache.evaluator, cache.reanchorInterval);
+}
+
+// nastavi atribut pozice VAO krivky na buffer bodu krivky
+void bindCurveStreamToVertexArray(StreamBuffer& curveStream, unsigned int VAO_curve)
+{
+    bindVertexArrayCached(VAO_curve);
+    bindBufferCached(GL_ARRAY_BUFFER, curveStream.buffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    curveStream.recreated = false;
+}
+
+std::vector<unsigned int> handlePointsIntoBuffers(glm::vec3 controlPoints[4], StreamBuffer& curveStream)
 { 
     
-    // VBO krivka a usecky
-    unsigned int VBO_control, VBO_curve, VBO_lines;
+    // VBO kontrolnich bodu, body krivky jsou v kruhovem bufferu (viz StreamBuffer)
+    unsigned int VBO_control;
     glGenBuffers(1, &VBO_control);
-    glGenBuffers(1, &VBO_curve);
-    glGenBuffers(1, &VBO_lines);
 
-    // VAO krivka a usecky
-    unsigned int VAO_control, VAO_curve, VAO_lines;
+    // VAO krivka a kontrolni body
+    unsigned int VAO_control, VAO_curve;
     glGenVertexArrays(1, &VAO_control);  
     glGenVertexArrays(1, &VAO_curve);
-    glGenVertexArrays(1, &VAO_lines);
+
+    // VAO krivky se nastavi jen jednou, oblast kruhoveho bufferu se vybira pres first v glDrawArrays
+    bindCurveStreamToVertexArray(curveStream, VAO_curve);
 
     // VAO and VBO pro kontrolni body
-    glBindVertexArray(VAO_control);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_control);
+    bindVertexArrayCached(VAO_control);
+    bindBufferCached(GL_ARRAY_BUFFER, VBO_control);
     glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(glm::vec3), controlPoints, GL_DYNAMIC_DRAW);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
-
-    // VAO and VBO pro body na krivce
-    glBindVertexArray(VAO_curve);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_curve);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // predani bufferu opengl pro cary mezi body na krivce
-    glBindVertexArray(VAO_lines);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_lines);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    bindVertexArrayCached(0);
 
     std::vector<unsigned int> a;
     a.push_back(VAO_curve);
-    a.push_back(VBO_curve);
-    a.push_back(VAO_lines);
-    a.push_back(VBO_lines);
     a.push_back(VAO_control);
     a.push_back(VBO_control);
     return a;
 }
 
 
-void render2DBezierCurve(const glm::vec3 controlPoints[4], float step, unsigned int shaderProgram,
-                         unsigned int VAO_curve, unsigned int VBO_curve, 
-                         unsigned int VAO_lines, unsigned int VBO_lines,
+// vykresli krivku z cache, body se zapisuji do kruhoveho bufferu jen kdyz se krivka zmenila
+// barva je konstantni atribut (krivka bila, kontrolni body cervene), ve VBO jsou jen pozice
+void render2DBezierCurve(CurveCache& cache, const ShaderProgram& shaderProgram,
+                         StreamBuffer& curveStream, unsigned int VAO_curve,
                          unsigned int VAO_control, unsigned int VBO_control) 
 {
-    std::vector<glm::vec3> curvePoints;
-    calculateBezierCurvePoints(controlPoints, step, curvePoints);
-
-    std::vector<float> curvePt;
-    for (const glm::vec3& point : curvePoints) {
-        // prirazeni barvy bodum na krivce
-        curvePt.push_back(point.x);
-        curvePt.push_back(point.y);
-        curvePt.push_back(point.z);
-        curvePt.push_back(1.0f);
-        curvePt.push_back(1.0f);
-        curvePt.push_back(1.0f);
-    }
+    CPU_ZONE("render2DBezierCurve");
+    // modelova matice je identita, nastavuje se jen pri vytvoreni programu
+    shaderProgram.Use();
 
-    std::vector<float> controlVertices;
-    for (int i = 0; i < 4; ++i) {
-        // prirazeni barvy kontrolnim bodum krivky
-        controlVertices.push_back(controlPoints[i].x);
-        controlVertices.push_back(controlPoints[i].y);
-        controlVertices.push_back(controlPoints[i].z);
-        controlVertices.push_back(1.0f);
-        controlVertices.push_back(0.0f);
-        controlVertices.push_back(0.0f);
-    }
+    if (cache.gpuDirty) {
+        glm::vec3* out = static_cast<glm::vec3*>(beginStreamBufferWrite(curveStream, cache.pointCount));
+        writeCurveCachePoints(cache, out);
+        endStreamBufferWrite(curveStream);
 
-    glUseProgram(shaderProgram);
+        // atribut VAO se meni jen kdyz se buffer pri zvetseni vymenil
+        if (curveStream.recreated) {
+            bindCurveStreamToVertexArray(curveStream, VAO_curve);
+        }
 
-    // ve 2d nedela nic, je to pouze identita
-    glm::mat4 model = glm::mat4(1.0f);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "modelMatrix"), 1, GL_FALSE, glm::value_ptr(model));
+        bindBufferCached(GL_ARRAY_BUFFER, VBO_control);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * sizeof(glm::vec3), cache.controlPoints);
+        cache.gpuDirty = false;
+    }
 
     // vykresleni krivky v opengl
-    glBindVertexArray(VAO_curve);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_curve);
-    glBufferData(GL_ARRAY_BUFFER, curvePt.size() * sizeof(float), curvePt.data(), GL_DYNAMIC_DRAW);
-    
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glDrawArrays(GL_LINE_STRIP, 0, curvePoints.size());
+    bindVertexArrayCached(VAO_curve);
+    glVertexAttrib3f(1, 1.0f, 1.0f, 1.0f);
+    beginGpuPass(GpuPass::Curve);
+    glDrawArrays(GL_LINE_STRIP, streamBufferFirst(curveStream), cache.pointCount);
+    endGpuPass(GpuPass::Curve);
 
     // vykresleni kontrolnich bodu krivky v opengl
-    glBindVertexArray(VAO_control);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_control);
-    glBufferData(GL_ARRAY_BUFFER, controlVertices.size() * sizeof(float), controlVertices.data(), GL_DYNAMIC_DRAW);
-
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
+    bindVertexArrayCached(VAO_control);
+    glVertexAttrib3f(1, 1.0f, 0.0f, 0.0f);
     // nastaveni velikosti bodu pro kontrolni body krivky
     glPointSize(5.0f);
+    beginGpuPass(GpuPass::ControlPoints);
     glDrawArrays(GL_POINTS, 0, 4);
-
-    // pridani cary mezi poslednim kontrolnim bodem a poslednim bodem z bodu krivky
-    if (!curvePoints.empty()) {
-        std::vector<float> lineVertices = {
-            controlPoints[3].x, controlPoints[3].y, controlPoints[3].z, 1.0f, 1.0f, 1.0f,
-            curvePoints.back().x, curvePoints.back().y, curvePoints.back().z, 1.0f, 1.0f, 1.0f
-        };
-
-        glBindVertexArray(VAO_lines);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO_lines);
-        glBufferData(GL_ARRAY_BUFFER, lineVertices.size() * sizeof(float), lineVertices.data(), GL_DYNAMIC_DRAW);
-
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glDrawArrays(GL_LINES, 0, 2);
-
-        glBindVertexArray(0);
-    }
-    glBindVertexArray(0);
+    endGpuPass(GpuPass::ControlPoints);
 }
@@ -9,6 +9,12 @@
 #include "gtc/matrix_transform.hpp"
 #include "gtc/type_ptr.hpp"
 #include <vector>
+#include <algorithm>
+#include "bezierBatch.h"
+#include "basisCache.h"
+#include "shaderProgram.h"
+#include "gpuProfiler.h"
+#include "cpuProfiler.h"
 
 // slouzi k vytvoreni 4x4 mrizky kontrolnich bodu plochy
 void generatePointsOnGrid(float a, float b, glm::vec3 controlPoints[4][4]) 
@@ -37,6 +43,37 @@ float bernstein(int i, float t)
     }
 }
 
+// derivace koeficientu bernsteinova polynomu podle t
+float bernsteinDerivative(int i, float t)
+{
+    switch (i) {
+        case 0: return -3 * (1 - t) * (1 - t);
+        case 1: return 3 * (1 - t) * (1 - t) - 6 * (1 - t) * t;
+        case 2: return 6 * (1 - t) * t - 3 * t * t;
+        case 3: return 3 * t * t;
+        default: return 0.0f;
+    }
+}
+
+// normala plochy z parcialnich derivaci podle u a v
+glm::vec3 bezierSurfaceNormal(glm::vec3 controlPoints[4][4], float u, float v)
+{
+    glm::vec3 du(0.0f);
+    glm::vec3 dv(0.0f);
+    for (int i = 0; i < 4; ++i) {
+        float Bu = bernstein(i, u);
+        float dBu = bernsteinDerivative(i, u);
+        for (int j = 0; j < 4; ++j) {
+            du += dBu * bernstein(j, v) * controlPoints[i][j];
+            dv += Bu * bernsteinDerivative(j, v) * controlPoints[i][j];
+        }
+    }
+    glm::vec3 n = glm::cross(du, dv);
+    float len = glm::length(n);
+    // v degenerovanem bode (napr. slity okraj) normala neexistuje
+    return len > 1e-12f ? n / len : glm::vec3(0.0f, 1.0f, 0.0f);
+}
+
 // slouzi pro vypocet jednotlivych bodu plochy
 glm::vec3 bezierSurface(glm::vec3 controlPoints[4][4], float u, float v) 
 {
@@ -52,56 +89,901 @@ glm::vec3 bezierSurface(glm::vec3 controlPoints[4][4], float u, float v)
     return point;
 }
 
-// vypocet vsech bodu plochy s krokem t
-void calculateBezierSurfacePoints(glm::vec3 controlPoints[4][4], float step, std::vector<glm::vec3>& surfacePoints) 
+// separabilni vypocet bodu plochy: radky site se nejdriv slozi ve smeru v, pak se 4 body slozi ve smeru u
+glm::vec3 bezierSurfaceSeparable(glm::vec3 controlPoints[4][4], float u, float v)
+{
+    float Bv[4] = { bernstein(0, v), bernstein(1, v), bernstein(2, v), bernstein(3, v) };
+    glm::vec3 point(0.0f);
+    for (int i = 0; i < 4; ++i) {
+        glm::vec3 row = Bv[0] * controlPoints[i][0] + Bv[1] * controlPoints[i][1]
+                      + Bv[2] * controlPoints[i][2] + Bv[3] * controlPoints[i][3];
+        point += bernstein(i, u) * row;
+    }
+    return point;
+}
+
+// normala z parcialnich derivaci, v degenerovanem bode (napr. slity okraj) normala neexistuje
+glm::vec3 surfaceNormalFromPartials(const glm::vec3& du, const glm::vec3& dv)
+{
+    glm::vec3 n = glm::cross(du, dv);
+    float len = glm::length(n);
+    return len > 1e-12f ? n / len : glm::vec3(0.0f, 1.0f, 0.0f);
+}
+
+// body plochy s indexy [first, last) v mrizce resolution x resolution (index = ku * resolution + kv, radky podle u)
+// zapisuje do points[0 .. last - first), pripadne i normaly a parcialni derivace (kazde zvlast podle zadanych poli)
+// nic nealokuje (krome prvniho vytvoreni sdilene tabulky baze), kazdy usek indexu lze spocitat nezavisle
+void evaluateBezierSurfaceSamples(glm::vec3 controlPoints[4][4], int resolution, int first, int last, glm::vec3* points,
+                                  glm::vec3* normals = nullptr, glm::vec3* surfaceDu = nullptr, glm::vec3* surfaceDv = nullptr)
+{
+    if (last <= first) {
+        return;
+    }
+    // parametry jsou ve smeru u i v stejne, baze (a jeji derivace) je ze sdilene tabulky
+    const BernsteinBasisTable& basis = bernsteinBasisTable(3, resolution);
+
+    // radky site slozene ve smeru v pro blok sloupcu mrizky (a jejich derivace podle v), na zasobniku
+    const int block = 64;
+    glm::vec3 rows[block * 4];
+    glm::vec3 rowsDv[block * 4];
+
+    int firstRow = first / resolution;
+    int lastRow = (last - 1) / resolution;
+    // v jedinem radku staci sloupce z useku, jinak jsou potreba vsechny
+    int firstColumn = firstRow == lastRow ? first % resolution : 0;
+    int lastColumn = firstRow == lastRow ? (last - 1) % resolution + 1 : resolution;
+
+    for (int blockBegin = firstColumn; blockBegin < lastColumn; blockBegin += block) {
+        int blockEnd = std::min(blockBegin + block, lastColumn);
+        for (int kv = blockBegin; kv < blockEnd; ++kv) {
+            const float* Bv = basis.row(kv);
+            const float* dBv = basis.derivativeRow(kv);
+            glm::vec3* r = &rows[(kv - blockBegin) * 4];
+            glm::vec3* rdv = &rowsDv[(kv - blockBegin) * 4];
+            for (int i = 0; i < 4; ++i) {
+                r[i] = Bv[0] * controlPoints[i][0] + Bv[1] * controlPoints[i][1]
+                     + Bv[2] * controlPoints[i][2] + Bv[3] * controlPoints[i][3];
+                rdv[i] = dBv[0] * controlPoints[i][0] + dBv[1] * controlPoints[i][1]
+                       + dBv[2] * controlPoints[i][2] + dBv[3] * controlPoints[i][3];
+            }
+        }
+
+        // kazdy bod je uz jen kombinace 4 slozenych radku s bazi ve smeru u
+        for (int ku = firstRow; ku <= lastRow; ++ku) {
+            const float* Bu = basis.row(ku);
+            const float* dBu = basis.derivativeRow(ku);
+            int rowStart = ku * resolution;
+            int begin = std::max(blockBegin, first - rowStart);
+            int end = std::min(blockEnd, last - rowStart);
+            for (int kv = begin; kv < end; ++kv) {
+                int k = rowStart + kv - first;
+                const glm::vec3* r = &rows[(kv - blockBegin) * 4];
+                points[k] = Bu[0] * r[0] + Bu[1] * r[1] + Bu[2] * r[2] + Bu[3] * r[3];
+                if (normals || (surfaceDu && surfaceDv)) {
+                    const glm::vec3* rdv = &rowsDv[(kv - blockBegin) * 4];
+                    glm::vec3 du = dBu[0] * r[0] + dBu[1] * r[1] + dBu[2] * r[2] + dBu[3] * r[3];
+                    glm::vec3 dv = Bu[0] * rdv[0] + Bu[1] * rdv[1] + Bu[2] * rdv[2] + Bu[3] * rdv[3];
+                    if (normals) {
+                        normals[k] = surfaceNormalFromPartials(du, dv);
+                    }
+                    if (surfaceDu && surfaceDv) {
+                        surfaceDu[k] = du;
+                        surfaceDv[k] = dv;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// vypocet vsech bodu plochy s krokem t, body jsou v mrizce resolution x resolution (radky podle u, viz bezierSampleCount)
+// pokud jsou zadany surfaceNormals nebo surfaceDu a surfaceDv, pocitaji se i normaly nebo parcialni derivace; vraci resolution
+int calculateBezierSurfacePoints(glm::vec3 controlPoints[4][4], float step, std::vector<glm::vec3>& surfacePoints,
+                                 std::vector<glm::vec3>* surfaceNormals = nullptr,
+                                 std::vector<glm::vec3>* surfaceDu = nullptr, std::vector<glm::vec3>* surfaceDv = nullptr) 
+{
+    CPU_ZONE("calculateBezierSurfacePoints");
+    int resolution = bezierSampleCount(step);
+    int count = resolution * resolution;
+    surfacePoints.resize(count);
+    glm::vec3* normals = nullptr;
+    glm::vec3* du = nullptr;
+    glm::vec3* dv = nullptr;
+    if (surfaceNormals) {
+        surfaceNormals->resize(count);
+        normals = surfaceNormals->data();
+    }
+    if (surfaceDu && surfaceDv) {
+        surfaceDu->resize(count);
+        surfaceDv->resize(count);
+        du = surfaceDu->data();
+        dv = surfaceDv->data();
+    }
+    evaluateBezierSurfaceSamples(controlPoints, resolution, 0, count, surfacePoints.data(), normals, du, dv);
+    return resolution;
+}
+
+/*
+ maticovy vypocet mrizky bodu: pro kazdou souradnici c je mrizka X_c = Bu * P_c * Bv^T
+ - Bu (nu x 4) a Bv (nv x 4) jsou navzorkovane bernsteinovy baze, spocitaji se jednou pro vsechny plochy
+ - nejdriv se spocita T_c = P_c * Bv^T (4 x nv), pak X_c = Bu * T_c po blocich sloupcu,
+   aby blok T zustal v L1 cache pres vsechny radky u
+ - vnitrni smycka (mikrojadro) pocita 4 sloupce v najednou pomoci SSE
+ - parcialni derivace jsou tytez souciny s derivaci baze v jednom smeru
+*/
+struct SurfaceGridBasis
+{
+    int nu = 0;
+    int nv = 0;
+    // sdilene tabulky baze, radky po 4 koeficientech
+    const BernsteinBasisTable* Bu = nullptr;
+    const BernsteinBasisTable* Bv = nullptr;
+};
+
+// baze pro nu x nv bodu vcetne okraju plochy (t = k / (n - 1))
+SurfaceGridBasis makeSurfaceGridBasis(int nu, int nv)
+{
+    SurfaceGridBasis basis;
+    basis.nu = nu;
+    basis.nv = nv;
+    basis.Bu = &bernsteinBasisTable(3, nu);
+    basis.Bv = &bernsteinBasisTable(3, nv);
+    return basis;
+}
+
+#if defined(BEZIER_BATCH_X86)
+// mikrojadro: o[v * stride] = bu * (t0, t1, t2, t3)[v] po 4 sloupcich, vraci prvni nespocitany sloupec
+BEZIER_TARGET_SSE2
+int surfaceGemmRowSse(const float* bu, const float* t0, const float* t1, const float* t2, const float* t3,
+                      float* o, int stride, int v, int v1)
 {
-    surfacePoints.clear();
-    for (float u = 0.0f; u <= 1.0f; u += step) {
-        for (float v = 0.0f; v <= 1.0f; v += step) {
-            surfacePoints.push_back(bezierSurface(controlPoints, u, v));
+    const __m128 b0 = _mm_set1_ps(bu[0]);
+    const __m128 b1 = _mm_set1_ps(bu[1]);
+    const __m128 b2 = _mm_set1_ps(bu[2]);
+    const __m128 b3 = _mm_set1_ps(bu[3]);
+    for (; v + 4 <= v1; v += 4) {
+        __m128 acc = _mm_mul_ps(b0, _mm_loadu_ps(t0 + v));
+        acc = _mm_add_ps(acc, _mm_mul_ps(b1, _mm_loadu_ps(t1 + v)));
+        acc = _mm_add_ps(acc, _mm_mul_ps(b2, _mm_loadu_ps(t2 + v)));
+        acc = _mm_add_ps(acc, _mm_mul_ps(b3, _mm_loadu_ps(t3 + v)));
+        if (stride == 1) {
+            _mm_storeu_ps(o + v, acc);
+        } else {
+            // prokladany vystup (glm::vec3), slozky se zapisi jednotlive
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, acc);
+            for (int lane = 0; lane < 4; ++lane) {
+                o[(v + lane) * stride] = lanes[lane];
+            }
         }
     }
+    return v;
 }
+#endif
 
-void render3DBezierSurface(glm::vec3 controlPoints[4][4], unsigned int shaderProgram, 
-                           unsigned int VAO_cube, int indexCount, float step)
+// vypocet mrizek bodu pro patchCount ploch najednou
+// plocha p zapisuje nu * nv hodnot od indexu p * nu * nv, radek u ma delku nv; hodnota k slozky c je outC[k * outStride]
+// (outStride = 1 jsou roviny x, y, z, outStride = 3 s out = &points[0].x, .y, .z zapisuje primo do pole glm::vec3)
+// scratch je pomocny buffer volajiciho, po prvnim pouziti se uz nealokuje
+// s derivativeU / derivativeV se misto baze v danem smeru pouzije jeji derivace (parcialni derivace plochy)
+void evaluateSurfacePatchesGemm(const glm::vec3 (*patches)[4][4], int patchCount, const SurfaceGridBasis& basis,
+                                std::vector<float>& scratch, float* outX, float* outY, float* outZ, int outStride = 1,
+                                bool derivativeU = false, bool derivativeV = false)
 {
+    const int nu = basis.nu;
+    const int nv = basis.nv;
+    // radky T zacinaji na nasobku 4 floatu
+    const int nvPadded = (nv + 3) & ~3;
+    const int blockV = 64;
+    scratch.resize(3 * 4 * nvPadded);
+    float* T = scratch.data();
+    float* out[3] = { outX, outY, outZ };
+#if defined(BEZIER_BATCH_X86)
+    // na i386 nemusi SSE2 byt, rozhoduje se za behu
+    static const bool useSse = detectSimdLevel() >= SimdLevel::SSE2;
+#endif
+
+    for (int p = 0; p < patchCount; ++p) {
+        const glm::vec3 (&P)[4][4] = patches[p];
+
+        // T_c = P_c * Bv^T
+        for (int c = 0; c < 3; ++c) {
+            for (int i = 0; i < 4; ++i) {
+                float* row = &T[(c * 4 + i) * nvPadded];
+                for (int v = 0; v < nv; ++v) {
+                    const float* bv = derivativeV ? basis.Bv->derivativeRow(v) : basis.Bv->row(v);
+                    row[v] = P[i][0][c] * bv[0] + P[i][1][c] * bv[1] + P[i][2][c] * bv[2] + P[i][3][c] * bv[3];
+                }
+            }
+        }
+
+        // X_c = Bu * T_c po blocich sloupcu
+        size_t patchOffset = static_cast<size_t>(p) * nu * nv;
+        for (int v0 = 0; v0 < nv; v0 += blockV) {
+            int v1 = std::min(v0 + blockV, nv);
+            for (int u = 0; u < nu; ++u) {
+                const float* bu = derivativeU ? basis.Bu->derivativeRow(u) : basis.Bu->row(u);
+                size_t rowOffset = patchOffset + static_cast<size_t>(u) * nv;
+                for (int c = 0; c < 3; ++c) {
+                    const float* t0 = &T[(c * 4 + 0) * nvPadded];
+                    const float* t1 = &T[(c * 4 + 1) * nvPadded];
+                    const float* t2 = &T[(c * 4 + 2) * nvPadded];
+                    const float* t3 = &T[(c * 4 + 3) * nvPadded];
+                    float* o = out[c] + rowOffset * outStride;
+                    int v = v0;
+#if defined(BEZIER_BATCH_X86)
+                    if (useSse) {
+                        v = surfaceGemmRowSse(bu, t0, t1, t2, t3, o, outStride, v, v1);
+                    }
+#endif
+                    for (; v < v1; ++v) {
+                        o[v * outStride] = bu[0] * t0[v] + bu[1] * t1[v] + bu[2] * t2[v] + bu[3] * t3[v];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// maticovy vypocet mrizky nu x nv bodu jedne plochy primo do pole bodu (radky podle u)
+// s surfaceNormals nebo surfaceDu a surfaceDv se dalsimi dvema souciny pocitaji parcialni derivace (a z nich normaly)
+void evaluateSurfaceGridGemm(glm::vec3 controlPoints[4][4], const SurfaceGridBasis& basis, std::vector<float>& scratch,
+                             std::vector<glm::vec3>& surfacePoints, std::vector<glm::vec3>* surfaceNormals = nullptr,
+                             std::vector<glm::vec3>* surfaceDu = nullptr, std::vector<glm::vec3>* surfaceDv = nullptr)
+{
+    size_t count = static_cast<size_t>(basis.nu) * basis.nv;
+    const glm::vec3 (*patch)[4][4] = reinterpret_cast<const glm::vec3 (*)[4][4]>(controlPoints);
+    auto evaluate = [&](std::vector<glm::vec3>& result, bool derivativeU, bool derivativeV) {
+        result.resize(count);
+        evaluateSurfacePatchesGemm(patch, 1, basis, scratch, &result[0].x, &result[0].y, &result[0].z, 3,
+                                   derivativeU, derivativeV);
+    };
+    evaluate(surfacePoints, false, false);
+    if (!surfaceNormals && !(surfaceDu && surfaceDv)) {
+        return;
+    }
+
+    std::vector<glm::vec3> localDu;
+    std::vector<glm::vec3> localDv;
+    std::vector<glm::vec3>& du = surfaceDu && surfaceDv ? *surfaceDu : localDu;
+    std::vector<glm::vec3>& dv = surfaceDu && surfaceDv ? *surfaceDv : localDv;
+    evaluate(du, true, false);
+    evaluate(dv, false, true);
+    if (!surfaceNormals) {
+        return;
+    }
+    surfaceNormals->resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        (*surfaceNormals)[k] = surfaceNormalFromPartials(du[k], dv[k]);
+    }
+}
+
+// indexy trojuhelniku pro mrizku resolution x resolution bodu (2 trojuhelniky na ctverec)
+void generateSurfaceGridIndices(int resolution, std::vector<unsigned int>& indices)
+{
+    indices.clear();
+    if (resolution < 2) {
+        return;
+    }
+    indices.reserve((resolution - 1) * (resolution - 1) * 6);
+    for (int i = 0; i + 1 < resolution; ++i) {
+        for (int j = 0; j + 1 < resolution; ++j) {
+            unsigned int a = i * resolution + j;
+            unsigned int b = a + 1;
+            unsigned int c = a + resolution;
+            unsigned int d = c + 1;
+            indices.insert(indices.end(), { a, c, b, b, c, d });
+        }
+    }
+}
+
+// buffery pro sit plochy, index buffer se meni jen pri zmene rozliseni
+struct SurfaceMesh
+{
+    unsigned int VAO = 0;
+    unsigned int VBO = 0;
+    unsigned int EBO = 0;
+    int indexResolution = 0;
+    int indexCount = 0;
+};
+
+SurfaceMesh handleSurfaceMeshIntoBuffers()
+{
+    SurfaceMesh mesh;
+    glGenVertexArrays(1, &mesh.VAO);
+    glGenBuffers(1, &mesh.VBO);
+    glGenBuffers(1, &mesh.EBO);
+
+    bindVertexArrayCached(mesh.VAO);
+    bindBufferCached(GL_ARRAY_BUFFER, mesh.VBO);
+    // pozice = layout 0
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    // normala = layout 1
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+    bindVertexArrayCached(0);
+    return mesh;
+}
+
+// ulozene vstupy a vysledky posledniho vypoctu plochy, aby se plocha neprepocitavala kazdy snimek
+struct SurfaceCache
+{
+    bool valid = false;
+    glm::vec3 controlPoints[4][4];
+    float step = 0.0f;
     std::vector<glm::vec3> surfacePoints;
-    glUseProgram(shaderProgram);
+    // parcialni derivace (z nich se pri nahrani site pocitaji normaly) a baze v parametrech mrizky,
+    // pro posun jednoho kontrolniho bodu
+    std::vector<glm::vec3> surfaceDu;
+    std::vector<glm::vec3> surfaceDv;
+    const BernsteinBasisTable* basis = nullptr;
+    // pomocny buffer maticoveho vypoctu (SurfaceBackend::CpuGemm)
+    std::vector<float> gemmScratch;
+    int resolution = 0;
+    // pocet posunu od posledniho uplneho vypoctu (omezuje hromadeni chyby floatu)
+    int incrementalUpdates = 0;
+    // instance krychli: posun (xyz) a meritko (w), nejdriv 16 kontrolnich bodu, pak body plochy
+    std::vector<glm::vec4> instances;
+    // obsah bufferu instanci a site neodpovida cache
+    bool gpuDirty = true;
+    // zmeneny usek bodu plochy [dirtyFirst, dirtyLast) a kontrolni bod pro castecne nahrani
+    int dirtyFirst = 0;
+    int dirtyLast = 0;
+    int dirtyControl = -1;
+};
+
+// usek indexu mrizky [first, last), ve kterem je baze index (nebo jeji derivace) nenulova
+void nonzeroBasisRange(const BernsteinBasisTable& basis, int resolution, int index, int& first, int& last)
+{
+    first = 0;
+    last = resolution;
+    while (first < last && basis.row(first)[index] == 0.0f && basis.derivativeRow(first)[index] == 0.0f) {
+        ++first;
+    }
+    while (last > first && basis.row(last - 1)[index] == 0.0f && basis.derivativeRow(last - 1)[index] == 0.0f) {
+        --last;
+    }
+}
 
-    // vykresleni krychli kontrolnich bodu plochy
+// posun kontrolniho bodu [row][col] na point zmeni kazdy bod plochy presne o B_row(u) * B_col(v) * delta,
+// takze se body a derivace jen opravi bez noveho vypoctu cele plochy
+// prochazi jen radky a sloupce, kde je baze bodu nenulova; normaly se nepocitaji, sit je bere z derivaci
+void applySurfaceControlPointMove(SurfaceCache& cache, int row, int col, const glm::vec3& point)
+{
+    const int resolution = cache.resolution;
+    const glm::vec3 delta = point - cache.controlPoints[row][col];
+    int rowFirst, rowLast, colFirst, colLast;
+    nonzeroBasisRange(*cache.basis, resolution, row, rowFirst, rowLast);
+    nonzeroBasisRange(*cache.basis, resolution, col, colFirst, colLast);
+    for (int ku = rowFirst; ku < rowLast; ++ku) {
+        glm::vec3 deltaU = cache.basis->row(ku)[row] * delta;
+        glm::vec3 deltaDu = cache.basis->derivativeRow(ku)[row] * delta;
+        for (int kv = colFirst; kv < colLast; ++kv) {
+            int k = ku * resolution + kv;
+            float Bv = cache.basis->row(kv)[col];
+            cache.surfacePoints[k] += Bv * deltaU;
+            cache.surfaceDu[k] += Bv * deltaDu;
+            cache.surfaceDv[k] += cache.basis->derivativeRow(kv)[col] * deltaU;
+            cache.instances[16 + k] = glm::vec4(cache.surfacePoints[k], 0.05f);
+        }
+    }
+
+    // presna hodnota bodu, aby se neodchylovala od vstupu
+    cache.controlPoints[row][col] = point;
+    cache.instances[row * 4 + col] = glm::vec4(point, 0.1f);
+
+    // zmeneny souvisly usek bodu, sjednoceny se zmenami, ktere jeste nebyly nahrany
+    int first = resolution * resolution;
+    int last = 0;
+    if (rowLast > rowFirst && colLast > colFirst) {
+        first = rowFirst * resolution + colFirst;
+        last = (rowLast - 1) * resolution + colLast;
+    }
+    if (cache.dirtyControl >= 0 && cache.dirtyControl != row * 4 + col) {
+        cache.gpuDirty = true;
+    }
+    if (cache.dirtyLast > cache.dirtyFirst) {
+        first = std::min(first, cache.dirtyFirst);
+        last = std::max(last, cache.dirtyLast);
+    }
+    cache.dirtyFirst = first;
+    cache.dirtyLast = std::max(last, first);
+    cache.dirtyControl = row * 4 + col;
+    ++cache.incrementalUpdates;
+}
+
+// prepocita body plochy jen pokud se od minula zmenil nektery vstup, vraci true pri zmene
+// pokud se zmenil jen jeden kontrolni bod, pouzije se oprava applySurfaceControlPointMove
+// gemm = uplny vypocet maticovym nasobenim (evaluateSurfaceGridGemm) misto evaluateBezierSurfaceSamples
+bool updateSurfaceCache(SurfaceCache& cache, glm::vec3 controlPoints[4][4], float step, bool gemm = false)
+{
+    CPU_ZONE("updateSurfaceCache");
+    if (cache.valid && cache.step == step &&
+        std::equal(&controlPoints[0][0], &controlPoints[0][0] + 16, &cache.controlPoints[0][0])) {
+        return false;
+    }
+
+    const int maxIncrementalUpdates = 256;
+    if (cache.valid && cache.step == step && cache.incrementalUpdates < maxIncrementalUpdates) {
+        int changed = -1;
+        int changedCount = 0;
+        for (int k = 0; k < 16; ++k) {
+            if (!(controlPoints[k / 4][k % 4] == cache.controlPoints[k / 4][k % 4])) {
+                changed = k;
+                ++changedCount;
+            }
+        }
+        if (changedCount == 1) {
+            int row = changed / 4;
+            int col = changed % 4;
+            applySurfaceControlPointMove(cache, row, col, controlPoints[row][col]);
+            return true;
+        }
+    }
+
+    std::copy(&controlPoints[0][0], &controlPoints[0][0] + 16, &cache.controlPoints[0][0]);
+    cache.step = step;
+    // normaly site se pocitaji z derivaci az pri nahrani (surfaceMeshVertices)
+    if (gemm) {
+        cache.resolution = bezierSampleCount(step);
+        evaluateSurfaceGridGemm(controlPoints, makeSurfaceGridBasis(cache.resolution, cache.resolution), cache.gemmScratch,
+                                cache.surfacePoints, nullptr, &cache.surfaceDu, &cache.surfaceDv);
+    } else {
+        cache.resolution = calculateBezierSurfacePoints(controlPoints, step, cache.surfacePoints, nullptr,
+                                                        &cache.surfaceDu, &cache.surfaceDv);
+    }
+    cache.basis = &bernsteinBasisTable(3, cache.resolution);
+    cache.incrementalUpdates = 0;
+
+    cache.instances.clear();
+    cache.instances.reserve(16 + cache.surfacePoints.size());
     for (int i = 0; i < 4; ++i) {
         for (int j = 0; j < 4; ++j) {
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, controlPoints[i][j]);
-            model = glm::scale(model, glm::vec3(0.1f));
+            cache.instances.push_back(glm::vec4(controlPoints[i][j], 0.1f));
+        }
+    }
+    for (const auto& surfacePoint : cache.surfacePoints) {
+        cache.instances.push_back(glm::vec4(surfacePoint, 0.05f));
+    }
+    cache.valid = true;
+    cache.gpuDirty = true;
+    return true;
+}
+
+// prokladana data site (pozice a normala) pro body plochy [first, last)
+// normala se nenormalizuje, jednotkovou delku ji da az shader
+void surfaceMeshVertices(const SurfaceCache& cache, int first, int last, std::vector<float>& meshVertices)
+{
+    meshVertices.clear();
+    meshVertices.reserve((last - first) * 6);
+    for (int i = first; i < last; ++i) {
+        const glm::vec3& p = cache.surfacePoints[i];
+        glm::vec3 n = glm::cross(cache.surfaceDu[i], cache.surfaceDv[i]);
+        meshVertices.insert(meshVertices.end(), { p.x, p.y, p.z, n.x, n.y, n.z });
+    }
+}
+
+// vykresli krychle kontrolnich bodu a bodu plochy jednim instancovanym volanim a sit plochy jednim volanim
+void render3DBezierSurface(SurfaceCache& cache, const ShaderProgram& shaderProgram, 
+                           unsigned int VAO_cube, unsigned int VBO_instances, int indexCount,
+                           const ShaderProgram& surfaceShaderProgram, SurfaceMesh& mesh,
+                           bool showMesh = true, bool showSampleMarkers = true)
+{
+    CPU_ZONE("render3DBezierSurface");
+    std::vector<float> meshVertices;
+    if (cache.gpuDirty) {
+        bindBufferCached(GL_ARRAY_BUFFER, VBO_instances);
+        glBufferData(GL_ARRAY_BUFFER, cache.instances.size() * sizeof(glm::vec4), cache.instances.data(), GL_DYNAMIC_DRAW);
+
+        surfaceMeshVertices(cache, 0, cache.surfacePoints.size(), meshVertices);
+        bindBufferCached(GL_ARRAY_BUFFER, mesh.VBO);
+        glBufferData(GL_ARRAY_BUFFER, meshVertices.size() * sizeof(float), meshVertices.data(), GL_DYNAMIC_DRAW);
+
+        // indexy se prepocitaji jen pri zmene rozliseni
+        if (mesh.indexResolution != cache.resolution) {
+            std::vector<unsigned int> indices;
+            generateSurfaceGridIndices(cache.resolution, indices);
+            bindVertexArrayCached(mesh.VAO);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+            bindVertexArrayCached(0);
+            mesh.indexResolution = cache.resolution;
+            mesh.indexCount = indices.size();
+        }
+    } else if (cache.dirtyControl >= 0) {
+        // po posunu jednoho kontrolniho bodu se nahraje jen zmeneny usek bez realokace bufferu
+        bindBufferCached(GL_ARRAY_BUFFER, VBO_instances);
+        glBufferSubData(GL_ARRAY_BUFFER, cache.dirtyControl * sizeof(glm::vec4), sizeof(glm::vec4),
+                        &cache.instances[cache.dirtyControl]);
+        if (cache.dirtyLast > cache.dirtyFirst) {
+            glBufferSubData(GL_ARRAY_BUFFER, (16 + cache.dirtyFirst) * sizeof(glm::vec4),
+                            (cache.dirtyLast - cache.dirtyFirst) * sizeof(glm::vec4), &cache.instances[16 + cache.dirtyFirst]);
+
+            surfaceMeshVertices(cache, cache.dirtyFirst, cache.dirtyLast, meshVertices);
+            bindBufferCached(GL_ARRAY_BUFFER, mesh.VBO);
+            glBufferSubData(GL_ARRAY_BUFFER, cache.dirtyFirst * 6 * sizeof(float),
+                            meshVertices.size() * sizeof(float), meshVertices.data());
+        }
+    }
+    cache.gpuDirty = false;
+    cache.dirtyFirst = 0;
+    cache.dirtyLast = 0;
+    cache.dirtyControl = -1;
+
+    // posun a meritko jsou v instancich, modelova matice je identita (nastavena pri vytvoreni programu)
+    shaderProgram.Use();
+
+    // prvnich 16 instanci jsou kontrolni body, zbytek body plochy
+    int instanceCount = showSampleMarkers ? cache.instances.size() : 16;
+    bindVertexArrayCached(VAO_cube);
+    beginGpuPass(GpuPass::SurfaceMarkers);
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, instanceCount);
+    endGpuPass(GpuPass::SurfaceMarkers);
+
+    if (showMesh) {
+        surfaceShaderProgram.Use();
+        bindVertexArrayCached(mesh.VAO);
+        beginGpuPass(GpuPass::SurfaceMesh);
+        glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
+        endGpuPass(GpuPass::SurfaceMesh);
+    }
+}
+
+// kde se pocitaji body plochy
+enum class SurfaceBackend
+{
+    Cpu = 0,
+    VertexShader = 1,
+    Tessellation = 2,
+    Compute = 3,
+    // CPU, uplny vypocet maticovym nasobenim
+    CpuGemm = 4
+};
+
+/*
+ vyhodnoceni plochy ve vertex shaderu (shaders/bezier_surface_vertex_shader.glsl)
+ - ve VBO jsou jen parametry (u, v) mrizky, nahraji se jednou pro kazde rozliseni
+ - kontrolni body jsou v uniform bloku ControlPoints, posun bodu je jen zapis 16 x vec4
+*/
+const unsigned int SurfaceControlPointsBinding = 0;
+
+struct SurfaceGpuGrid
+{
+    unsigned int VAO = 0;
+    unsigned int VBO = 0;
+    unsigned int EBO = 0;
+    unsigned int UBO = 0;
+    int resolution = 0;
+    int indexCount = 0;
+    // kontrolni body naposledy zapsane do UBO a bufferu instanci
+    bool controlPointsValid = false;
+    glm::vec3 controlPoints[4][4];
+};
+
+SurfaceGpuGrid handleSurfaceGpuGridIntoBuffers(const ShaderProgram& gpuSurfaceProgram)
+{
+    SurfaceGpuGrid grid;
+    glGenVertexArrays(1, &grid.VAO);
+    glGenBuffers(1, &grid.VBO);
+    glGenBuffers(1, &grid.EBO);
+    glGenBuffers(1, &grid.UBO);
+
+    bindVertexArrayCached(grid.VAO);
+    bindBufferCached(GL_ARRAY_BUFFER, grid.VBO);
+    // parametry (u, v) = layout 0
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, grid.EBO);
+    bindVertexArrayCached(0);
+
+    bindBufferCached(GL_UNIFORM_BUFFER, grid.UBO);
+    glBufferData(GL_UNIFORM_BUFFER, 16 * sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW);
+    bindBufferBaseCached(GL_UNIFORM_BUFFER, SurfaceControlPointsBinding, grid.UBO);
+    gpuSurfaceProgram.BindUniformBlock("ControlPoints", SurfaceControlPointsBinding);
+    return grid;
+}
+
+// nahraje parametry a indexy mrizky resolution x resolution (stejne parametry jako pri vypoctu na CPU)
+void updateSurfaceGpuGridResolution(SurfaceGpuGrid& grid, int resolution)
+{
+    std::vector<float> params;
+    params.reserve(resolution * resolution * 2);
+    for (int ku = 0; ku < resolution; ++ku) {
+        for (int kv = 0; kv < resolution; ++kv) {
+            params.push_back(bezierSampleParameter(ku, resolution));
+            params.push_back(bezierSampleParameter(kv, resolution));
+        }
+    }
+    std::vector<unsigned int> indices;
+    generateSurfaceGridIndices(resolution, indices);
+
+    bindVertexArrayCached(grid.VAO);
+    bindBufferCached(GL_ARRAY_BUFFER, grid.VBO);
+    glBufferData(GL_ARRAY_BUFFER, params.size() * sizeof(float), params.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    bindVertexArrayCached(0);
+    grid.resolution = resolution;
+    grid.indexCount = indices.size();
+}
+
+// krychle 16 kontrolnich bodu (bez bodu plochy), instance se nahraji jen pri zmene kontrolnich bodu
+void renderSurfaceControlMarkers(glm::vec3 controlPoints[4][4], bool upload, const ShaderProgram& shaderProgram,
+                                 unsigned int VAO_cube, unsigned int VBO_instances, int indexCount)
+{
+    if (upload) {
+        glm::vec4 instances[16];
+        for (int k = 0; k < 16; ++k) {
+            instances[k] = glm::vec4(controlPoints[k / 4][k % 4], 0.1f);
+        }
+        bindBufferCached(GL_ARRAY_BUFFER, VBO_instances);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(instances), instances, GL_DYNAMIC_DRAW);
+    }
 
-            glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "modelMatrix"), 1, GL_FALSE, glm::value_ptr(model));
+    shaderProgram.Use();
+    bindVertexArrayCached(VAO_cube);
+    beginGpuPass(GpuPass::SurfaceMarkers);
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, 16);
+    endGpuPass(GpuPass::SurfaceMarkers);
+}
 
-            glBindVertexArray(VAO_cube);
-            glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+// vykresli kontrolni body a plochu vyhodnocenou na GPU, na CPU se nic nepocita
+// (body plochy na CPU nejsou, proto se kresli jen krychle kontrolnich bodu)
+void render3DBezierSurfaceGpu(SurfaceGpuGrid& grid, glm::vec3 controlPoints[4][4], float step,
+                              const ShaderProgram& shaderProgram, unsigned int VAO_cube, unsigned int VBO_instances, int indexCount,
+                              const ShaderProgram& gpuSurfaceProgram, bool showMesh = true)
+{
+    CPU_ZONE("render3DBezierSurfaceGpu");
+    int resolution = bezierSampleCount(step);
+    if (grid.resolution != resolution) {
+        updateSurfaceGpuGridResolution(grid, resolution);
+    }
+
+    bool changed = !grid.controlPointsValid ||
+                   !std::equal(&controlPoints[0][0], &controlPoints[0][0] + 16, &grid.controlPoints[0][0]);
+    if (changed) {
+        glm::vec4 uniformPoints[16];
+        for (int k = 0; k < 16; ++k) {
+            uniformPoints[k] = glm::vec4(controlPoints[k / 4][k % 4], 1.0f);
         }
+        bindBufferCached(GL_UNIFORM_BUFFER, grid.UBO);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(uniformPoints), uniformPoints);
+        std::copy(&controlPoints[0][0], &controlPoints[0][0] + 16, &grid.controlPoints[0][0]);
+        grid.controlPointsValid = true;
+    }
+    renderSurfaceControlMarkers(controlPoints, changed, shaderProgram, VAO_cube, VBO_instances, indexCount);
+
+    if (showMesh) {
+        gpuSurfaceProgram.Use();
+        bindVertexArrayCached(grid.VAO);
+        beginGpuPass(GpuPass::SurfaceMesh);
+        glDrawElements(GL_TRIANGLES, grid.indexCount, GL_UNSIGNED_INT, 0);
+        endGpuPass(GpuPass::SurfaceMesh);
+    }
+}
+
+/*
+ hardwarova teselace plochy (GL_ARB_tessellation_shader, shaders/tess_*.glsl)
+ - kontrolni body se kresli jako jeden GL_PATCHES s 16 vrcholy
+ - tess control shader vybira uroven deleni hran podle velikosti plochy na obrazovce,
+   takze hustota site se meni se vzdalenosti a CPU nepocita zadne body plochy
+*/
+struct SurfaceTessellationPatch
+{
+    unsigned int VAO = 0;
+    unsigned int VBO = 0;
+    bool controlPointsValid = false;
+    glm::vec3 controlPoints[4][4];
+    // lokace uniforem teselacniho programu, zjisti se jednou pri vytvoreni
+    GLint viewportSizeLocation = -1;
+    GLint pixelsPerSegmentLocation = -1;
+};
+
+SurfaceTessellationPatch handleSurfaceTessellationIntoBuffers(const ShaderProgram& tessSurfaceProgram)
+{
+    SurfaceTessellationPatch patch;
+    patch.viewportSizeLocation = tessSurfaceProgram.UniformLocation("viewportSize");
+    patch.pixelsPerSegmentLocation = tessSurfaceProgram.UniformLocation("pixelsPerSegment");
+    glGenVertexArrays(1, &patch.VAO);
+    glGenBuffers(1, &patch.VBO);
+
+    bindVertexArrayCached(patch.VAO);
+    bindBufferCached(GL_ARRAY_BUFFER, patch.VBO);
+    glBufferData(GL_ARRAY_BUFFER, 16 * sizeof(glm::vec3), nullptr, GL_DYNAMIC_DRAW);
+    // kontrolni bod = layout 0
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    bindVertexArrayCached(0);
+    return patch;
+}
+
+// vykresli kontrolni body a plochu teselovanou na GPU, pixelsPerSegment je cilova delka useku site v pixelech
+void render3DBezierSurfaceTessellated(SurfaceTessellationPatch& patch, glm::vec3 controlPoints[4][4],
+                                      const ShaderProgram& shaderProgram, unsigned int VAO_cube, unsigned int VBO_instances, int indexCount,
+                                      const ShaderProgram& tessSurfaceProgram, int viewportWidth, int viewportHeight,
+                                      float pixelsPerSegment, bool showMesh = true)
+{
+    CPU_ZONE("render3DBezierSurfaceTessellated");
+    bool changed = !patch.controlPointsValid ||
+                   !std::equal(&controlPoints[0][0], &controlPoints[0][0] + 16, &patch.controlPoints[0][0]);
+    if (changed) {
+        bindBufferCached(GL_ARRAY_BUFFER, patch.VBO);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, 16 * sizeof(glm::vec3), &controlPoints[0][0]);
+        std::copy(&controlPoints[0][0], &controlPoints[0][0] + 16, &patch.controlPoints[0][0]);
+        patch.controlPointsValid = true;
+    }
+    renderSurfaceControlMarkers(controlPoints, changed, shaderProgram, VAO_cube, VBO_instances, indexCount);
+
+    if (showMesh) {
+        tessSurfaceProgram.Use();
+        tessSurfaceProgram.SetVec2(patch.viewportSizeLocation, glm::vec2(viewportWidth, viewportHeight));
+        tessSurfaceProgram.SetFloat(patch.pixelsPerSegmentLocation, pixelsPerSegment);
+        bindVertexArrayCached(patch.VAO);
+        glPatchParameteri(GL_PATCH_VERTICES, 16);
+        beginGpuPass(GpuPass::SurfaceMesh);
+        glDrawArrays(GL_PATCHES, 0, 16);
+        endGpuPass(GpuPass::SurfaceMesh);
     }
+}
+
+/*
+ vypocet ploch compute shaderem (GL 4.3, shaders/bezier_surface_compute_shader.glsl)
+ - kontrolni site vsech ploch jsou v jednom SSBO, body (pozice + normala) se zapisou do dalsiho SSBO,
+   ktery se zaroven pouziva jako vertex buffer site
+ - shader zapise i argumenty pro glMultiDrawElementsIndirect, vsechny plochy se kresli jednim volanim
+   a data ani zmena hustoty site nejdou pres CPU
+*/
+const unsigned int SurfaceComputeControlBinding = 0;
+const unsigned int SurfaceComputeVertexBinding = 1;
+const unsigned int SurfaceComputeCommandBinding = 2;
 
-    
-    calculateBezierSurfacePoints(controlPoints, step, surfacePoints);
+// rozlozeni podle specifikace glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
 
-    // vykresleni krychli bodu plochy
-    for (const auto& surfacePoint : surfacePoints) {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, surfacePoint);
-        model = glm::scale(model, glm::vec3(0.05f));
+struct SurfaceComputeBatch
+{
+    unsigned int VAO = 0;
+    unsigned int controlBuffer = 0;
+    unsigned int vertexBuffer = 0;
+    unsigned int commandBuffer = 0;
+    unsigned int EBO = 0;
+    int patchCount = 0;
+    int resolution = 0;
+    int indexCount = 0;
+    // pocet bodu, pro ktere je alokovany vertexBuffer
+    int vertexCapacity = 0;
+    // kontrolni site se zmenily od posledniho vypoctu
+    bool dirty = true;
+    // kontrolni body jedine plochy pro render3DBezierSurfaceCompute
+    bool controlPointsValid = false;
+    glm::vec3 controlPoints[4][4];
+    // lokace uniforem compute programu, zjisti se jednou pri vytvoreni
+    GLint resolutionLocation = -1;
+    GLint indexCountLocation = -1;
+};
 
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "modelMatrix"), 1, GL_FALSE, glm::value_ptr(model));
+SurfaceComputeBatch handleSurfaceComputeIntoBuffers(const ShaderProgram& computeProgram)
+{
+    SurfaceComputeBatch batch;
+    batch.resolutionLocation = computeProgram.UniformLocation("resolution");
+    batch.indexCountLocation = computeProgram.UniformLocation("indexCount");
+    glGenVertexArrays(1, &batch.VAO);
+    glGenBuffers(1, &batch.controlBuffer);
+    glGenBuffers(1, &batch.vertexBuffer);
+    glGenBuffers(1, &batch.commandBuffer);
+    glGenBuffers(1, &batch.EBO);
 
-        glBindVertexArray(VAO_cube);
-        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+    // stejne rozlozeni jako SurfaceMesh, kresli se shaderem surface_vertex_shader.glsl
+    bindVertexArrayCached(batch.VAO);
+    bindBufferCached(GL_ARRAY_BUFFER, batch.vertexBuffer);
+    // pozice = layout 0
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    // normala = layout 1
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.EBO);
+    bindVertexArrayCached(0);
+    return batch;
+}
+
+// nahraje kontrolni site patchCount ploch
+void uploadSurfaceComputePatches(SurfaceComputeBatch& batch, const glm::vec3 (*patches)[4][4], int patchCount)
+{
+    std::vector<glm::vec4> controlPoints;
+    controlPoints.reserve(patchCount * 16);
+    for (int p = 0; p < patchCount; ++p) {
+        for (int k = 0; k < 16; ++k) {
+            controlPoints.push_back(glm::vec4(patches[p][k / 4][k % 4], 1.0f));
+        }
+    }
+    bindBufferCached(GL_SHADER_STORAGE_BUFFER, batch.controlBuffer);
+    if (patchCount == batch.patchCount) {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, controlPoints.size() * sizeof(glm::vec4), controlPoints.data());
+    } else {
+        glBufferData(GL_SHADER_STORAGE_BUFFER, controlPoints.size() * sizeof(glm::vec4), controlPoints.data(), GL_DYNAMIC_DRAW);
+        bindBufferCached(GL_DRAW_INDIRECT_BUFFER, batch.commandBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, patchCount * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+        batch.patchCount = patchCount;
     }
-    glBindVertexArray(0);
+    batch.dirty = true;
 }
 
+// spocita body vsech ploch v mrizce resolution x resolution a argumenty kresleni, vse zustava na GPU
+void dispatchSurfaceCompute(SurfaceComputeBatch& batch, const ShaderProgram& computeProgram, int resolution)
+{
+    if (resolution != batch.resolution) {
+        std::vector<unsigned int> indices;
+        generateSurfaceGridIndices(resolution, indices);
+        bindVertexArrayCached(batch.VAO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        bindVertexArrayCached(0);
+        batch.resolution = resolution;
+        batch.indexCount = indices.size();
+        batch.dirty = true;
+    }
+    if (!batch.dirty || batch.patchCount == 0) {
+        return;
+    }
 
+    int vertexCount = batch.patchCount * resolution * resolution;
+    if (vertexCount > batch.vertexCapacity) {
+        bindBufferCached(GL_SHADER_STORAGE_BUFFER, batch.vertexBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(vertexCount) * 6 * sizeof(float), nullptr, GL_DYNAMIC_COPY);
+        batch.vertexCapacity = vertexCount;
+    }
 
+    computeProgram.Use();
+    computeProgram.SetInt(batch.resolutionLocation, resolution);
+    computeProgram.SetInt(batch.indexCountLocation, batch.indexCount);
+    bindBufferBaseCached(GL_SHADER_STORAGE_BUFFER, SurfaceComputeControlBinding, batch.controlBuffer);
+    bindBufferBaseCached(GL_SHADER_STORAGE_BUFFER, SurfaceComputeVertexBinding, batch.vertexBuffer);
+    bindBufferBaseCached(GL_SHADER_STORAGE_BUFFER, SurfaceComputeCommandBinding, batch.commandBuffer);
+    const int localSize = 64;
+    beginGpuPass(GpuPass::Compute);
+    glDispatchCompute((resolution * resolution + localSize - 1) / localSize, batch.patchCount, 1);
+    endGpuPass(GpuPass::Compute);
+    // vysledek se cte jako vrcholy a jako argumenty kresleni
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+    batch.dirty = false;
+}
 
+// vykresli vsechny plochy jednim glMultiDrawElementsIndirect
+void drawSurfaceCompute(const SurfaceComputeBatch& batch, const ShaderProgram& surfaceProgram)
+{
+    surfaceProgram.Use();
+    bindVertexArrayCached(batch.VAO);
+    bindBufferCached(GL_DRAW_INDIRECT_BUFFER, batch.commandBuffer);
+    beginGpuPass(GpuPass::SurfaceMesh);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, batch.patchCount, 0);
+    endGpuPass(GpuPass::SurfaceMesh);
+}
 
+// vykresli kontrolni body a plochu spocitanou compute shaderem, prepocita se jen pri zmene bodu nebo kroku
+void render3DBezierSurfaceCompute(SurfaceComputeBatch& batch, glm::vec3 controlPoints[4][4], float step,
+                                  const ShaderProgram& shaderProgram, unsigned int VAO_cube, unsigned int VBO_instances, int indexCount,
+                                  const ShaderProgram& computeProgram, const ShaderProgram& surfaceProgram, bool showMesh = true)
+{
+    CPU_ZONE("render3DBezierSurfaceCompute");
+    bool changed = !batch.controlPointsValid ||
+                   !std::equal(&controlPoints[0][0], &controlPoints[0][0] + 16, &batch.controlPoints[0][0]);
+    if (changed) {
+        const glm::vec3 (*patch)[4][4] = reinterpret_cast<const glm::vec3 (*)[4][4]>(controlPoints);
+        uploadSurfaceComputePatches(batch, patch, 1);
+        std::copy(&controlPoints[0][0], &controlPoints[0][0] + 16, &batch.controlPoints[0][0]);
+        batch.controlPointsValid = true;
+    }
+    dispatchSurfaceCompute(batch, computeProgram, bezierSampleCount(step));
+    renderSurfaceControlMarkers(controlPoints, changed, shaderProgram, VAO_cube, VBO_instances, indexCount);
 
+    if (showMesh) {
+        drawSurfaceCompute(batch, surfaceProgram);
+    }
+}
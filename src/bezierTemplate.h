@@ -0,0 +1,237 @@
+#pragma once
+#include "glm.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*
+ bezierovy krivky a plochy libovolneho stupne urceneho pri prekladu
+ - binomicke koeficienty a tabulky bazi se pocitaji jako constexpr
+ - soucty pres kontrolni body se rozbali pomoci fold vyrazu, takze kazdy stupen
+   dostane vlastni plne rozbalenou funkci bez smycek a bez switch
+ - Degree = 3 odpovida bezierCurve/bernstein, M = N = 3 odpovida bezierSurface
+*/
+
+// pocet bodu pro krok step (nejmene 2, aby byly oba okraje)
+int bezierSampleCount(float step)
+{
+    if (!(step > 0.0f)) {
+        return 2;
+    }
+    return std::max(2, static_cast<int>(std::floor(1.0f / step + 0.5f)) + 1);
+}
+
+// parametr k-teho bodu z sampleCount, posledni bod ma presne t = 1
+float bezierSampleParameter(int k, int sampleCount)
+{
+    return static_cast<float>(k) / static_cast<float>(sampleCount - 1);
+}
+
+// binomicky koeficient n nad k
+constexpr int binomial(int n, int k)
+{
+    if (k < 0 || k > n) {
+        return 0;
+    }
+    int result = 1;
+    for (int i = 1; i <= k; ++i) {
+        result = result * (n - k + i) / i;
+    }
+    return result;
+}
+
+static_assert(binomial(3, 1) == 3 && binomial(5, 2) == 10, "binomial");
+static_assert(binomial(4, 2) == 6 && binomial(5, 0) == 1 && binomial(5, 5) == 1, "binomial");
+static_assert(binomial(3, 4) == 0 && binomial(3, -1) == 0, "binomial outside of the triangle");
+
+// radek pascalova trojuhelniku pro dany stupen (koeficienty bernsteinova polynomu)
+template<int Degree>
+constexpr std::array<float, Degree + 1> bernsteinBinomials()
+{
+    std::array<float, Degree + 1> row{};
+    for (int i = 0; i <= Degree; ++i) {
+        row[i] = static_cast<float>(binomial(Degree, i));
+    }
+    return row;
+}
+
+// x^Exp s exponentem znamym pri prekladu
+template<int Exp>
+constexpr float powN(float x)
+{
+    if constexpr (Exp == 0) {
+        return 1.0f;
+    } else {
+        return powN<Exp - 1>(x) * x;
+    }
+}
+
+// i-ty bernsteinuv polynom stupne Degree, s = 1 - t
+template<int Degree, int I>
+constexpr float bernsteinN(float t, float s)
+{
+    static_assert(I >= 0 && I <= Degree, "bernstein index out of range");
+    constexpr float coefficient = static_cast<float>(binomial(Degree, I));
+    return coefficient * powN<Degree - I>(s) * powN<I>(t);
+}
+
+// vsechny bernsteinovy polynomy stupne Degree v parametru t
+template<int Degree, std::size_t... I>
+constexpr std::array<float, Degree + 1> bernsteinBasisImpl(float t, std::index_sequence<I...>)
+{
+    float s = 1.0f - t;
+    return {{ bernsteinN<Degree, static_cast<int>(I)>(t, s)... }};
+}
+
+template<int Degree>
+constexpr std::array<float, Degree + 1> bernsteinBasis(float t)
+{
+    return bernsteinBasisImpl<Degree>(t, std::make_index_sequence<Degree + 1>{});
+}
+
+// soucet bazi (v kazdem t ma byt 1)
+template<int Degree>
+constexpr float bernsteinBasisSum(float t)
+{
+    std::array<float, Degree + 1> basis = bernsteinBasis<Degree>(t);
+    float sum = 0.0f;
+    for (float b : basis) {
+        sum += b;
+    }
+    return sum;
+}
+
+// hodnoty v t = 0.5 jsou presne (mocniny dvou), lze je porovnat bez tolerance
+static_assert(bernsteinN<2, 1>(0.5f, 0.5f) == 0.5f, "bernsteinN");
+static_assert(bernsteinN<3, 1>(0.5f, 0.5f) == 0.375f, "bernsteinN");
+static_assert(bernsteinN<4, 2>(0.5f, 0.5f) == 0.375f, "bernsteinN");
+static_assert(bernsteinN<5, 0>(0.0f, 1.0f) == 1.0f && bernsteinN<5, 5>(0.0f, 1.0f) == 0.0f, "bernsteinN endpoints");
+static_assert(bernsteinBasisSum<2>(0.5f) == 1.0f && bernsteinBasisSum<4>(0.5f) == 1.0f && bernsteinBasisSum<5>(0.5f) == 1.0f,
+              "bernstein partition of unity");
+
+// tabulka bazi pro Samples rovnomerne rozlozenych parametru vcetne 0 a 1, vypocitana pri prekladu
+// (za behu pro libovolny stupen viz bernsteinBasisTable v basisCache.h)
+template<int Degree, int Samples>
+constexpr std::array<std::array<float, Degree + 1>, Samples> bernsteinBasisTableN()
+{
+    static_assert(Samples >= 2, "basis table needs both endpoints");
+    std::array<std::array<float, Degree + 1>, Samples> table{};
+    for (int k = 0; k < Samples; ++k) {
+        float t = static_cast<float>(k) / static_cast<float>(Samples - 1);
+        float s = 1.0f - t;
+        for (int i = 0; i <= Degree; ++i) {
+            float w = static_cast<float>(binomial(Degree, i));
+            for (int e = 0; e < Degree - i; ++e) {
+                w *= s;
+            }
+            for (int e = 0; e < i; ++e) {
+                w *= t;
+            }
+            table[k][i] = w;
+        }
+    }
+    return table;
+}
+
+static_assert(bernsteinBasisTableN<4, 5>()[0][0] == 1.0f && bernsteinBasisTableN<4, 5>()[4][4] == 1.0f &&
+              bernsteinBasisTableN<4, 5>()[2][2] == 0.375f, "basis table");
+
+// baze ze sablony (rozbaleny soucin bernsteinN) proti tabulce pocitane smyckami ve vsech Samples parametrech,
+// soucet bazi musi byt 1
+template<int Degree, int Samples>
+constexpr bool bernsteinBasisMatchesTable(float tolerance)
+{
+    constexpr std::array<std::array<float, Degree + 1>, Samples> table = bernsteinBasisTableN<Degree, Samples>();
+    for (int k = 0; k < Samples; ++k) {
+        std::array<float, Degree + 1> basis = bernsteinBasis<Degree>(static_cast<float>(k) / static_cast<float>(Samples - 1));
+        float sum = 0.0f;
+        for (int i = 0; i <= Degree; ++i) {
+            float difference = basis[i] - table[k][i];
+            if (difference > tolerance || difference < -tolerance) {
+                return false;
+            }
+            sum += basis[i];
+        }
+        if (sum - 1.0f > tolerance || 1.0f - sum > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// stupne, ktere program jinak nepouziva, se overi pri prekladu
+static_assert(bernsteinBasisMatchesTable<2, 17>(1e-6f), "degree 2 template basis");
+static_assert(bernsteinBasisMatchesTable<4, 17>(1e-6f), "degree 4 template basis");
+static_assert(bernsteinBasisMatchesTable<5, 17>(1e-6f), "degree 5 template basis");
+
+template<int Degree, std::size_t... I>
+glm::vec3 bezierCurveImpl(const glm::vec3 (&controlPoints)[Degree + 1], float t, std::index_sequence<I...>)
+{
+    float s = 1.0f - t;
+    return ((bernsteinN<Degree, static_cast<int>(I)>(t, s) * controlPoints[I]) + ...);
+}
+
+// bod bezierovy krivky stupne Degree (Degree + 1 kontrolnich bodu)
+template<int Degree>
+glm::vec3 bezierCurveN(const glm::vec3 (&controlPoints)[Degree + 1], float t)
+{
+    static_assert(Degree >= 1, "curve degree must be at least 1");
+    return bezierCurveImpl<Degree>(controlPoints, t, std::make_index_sequence<Degree + 1>{});
+}
+
+template<int M, int N, std::size_t... I>
+glm::vec3 bezierSurfaceImpl(const glm::vec3 (&controlPoints)[M + 1][N + 1], float u, float v, std::index_sequence<I...>)
+{
+    float s = 1.0f - u;
+    // nejdriv se kazdy radek site slozi ve smeru v, pak se radky slozi ve smeru u
+    return ((bernsteinN<M, static_cast<int>(I)>(u, s) * bezierCurveN<N>(controlPoints[I], v)) + ...);
+}
+
+// bod bezierovy plochy stupne M x N (site (M + 1) x (N + 1) kontrolnich bodu)
+template<int M, int N>
+glm::vec3 bezierSurfaceN(const glm::vec3 (&controlPoints)[M + 1][N + 1], float u, float v)
+{
+    static_assert(M >= 1 && N >= 1, "surface degree must be at least 1");
+    return bezierSurfaceImpl<M, N>(controlPoints, u, v, std::make_index_sequence<M + 1>{});
+}
+
+// body krivky s indexy [first, last) z sampleCount bodu, out[i - first] je bod s parametrem bezierSampleParameter(i)
+// nic nealokuje, kazdy usek indexu lze spocitat nezavisle
+template<int Degree>
+void evaluateBezierCurveSamplesN(const glm::vec3 (&controlPoints)[Degree + 1], int sampleCount, int first, int last, glm::vec3* out)
+{
+    for (int k = first; k < last; ++k) {
+        out[k - first] = bezierCurveN<Degree>(controlPoints, bezierSampleParameter(k, sampleCount));
+    }
+}
+
+// body plochy s indexy [first, last) v mrizce resolution x resolution (index = ku * resolution + kv)
+template<int M, int N>
+void evaluateBezierSurfaceSamplesN(const glm::vec3 (&controlPoints)[M + 1][N + 1], int resolution, int first, int last, glm::vec3* out)
+{
+    for (int k = first; k < last; ++k) {
+        out[k - first] = bezierSurfaceN<M, N>(controlPoints, bezierSampleParameter(k / resolution, resolution),
+                                              bezierSampleParameter(k % resolution, resolution));
+    }
+}
+
+// body krivky stupne Degree s krokem step (pocet bodu viz bezierSampleCount)
+template<int Degree>
+void calculateBezierCurvePointsN(const glm::vec3 (&controlPoints)[Degree + 1], float step, std::vector<glm::vec3>& curvePoints)
+{
+    int count = bezierSampleCount(step);
+    curvePoints.resize(count);
+    evaluateBezierCurveSamplesN<Degree>(controlPoints, count, 0, count, curvePoints.data());
+}
+
+// body plochy stupne M x N s krokem step
+template<int M, int N>
+void calculateBezierSurfacePointsN(const glm::vec3 (&controlPoints)[M + 1][N + 1], float step, std::vector<glm::vec3>& surfacePoints)
+{
+    int resolution = bezierSampleCount(step);
+    surfacePoints.resize(resolution * resolution);
+    evaluateBezierSurfaceSamplesN<M, N>(controlPoints, resolution, 0, resolution * resolution, surfacePoints.data());
+}
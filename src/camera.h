@@ -7,6 +7,7 @@
 #include "gtc/type_ptr.hpp"
 #include "gtx/rotate_vector.hpp"
 #include "gtx/vector_angle.hpp"
+#include "shaderProgram.h"
 
 class Camera 
 {
@@ -20,6 +21,8 @@ class Camera
     float speed = 0.1f;
     float slowerSpeed = 0.03f;
     float sensitivity = 100.0f;
+    // uniform buffer s matici kamery (vytvori se pri prvnim UpdateMatrix)
+    unsigned int UniformBuffer = 0;
 
     Camera(int w, int h, glm::vec3 pos)
     {
@@ -28,7 +31,7 @@ class Camera
         Position = pos;
     }
 
-    void Matrix(float FOVdeg, float nearPlane, float farPlane, unsigned int shaderProgram, const char* uniform, bool is2DMode)
+    glm::mat4 GetMatrix(float FOVdeg, float nearPlane, float farPlane, bool is2DMode)
     {
         // 2 matice zobrazeni a to pohledova a projekcni (vysledek je zavisly na kombinaci techto dvou matic)
         glm::mat4 view = glm::mat4(1.0f);
@@ -41,9 +44,24 @@ class Camera
             projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
         } else {
             view = glm::lookAt(Position, glm::vec3(0.0f, 0.0f, 0.0f), Up);
-            projection = glm::perspective(glm::radians(FOVdeg), (float)(width / height), nearPlane, farPlane);
+            projection = glm::perspective(glm::radians(FOVdeg), (float)width / (float)height, nearPlane, farPlane);
         }
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, uniform), 1, GL_FALSE, glm::value_ptr(projection * view));
+        return projection * view;
+    }
+
+    // zapise matici kamery do sdileneho uniform bufferu, jeden zapis za snimek staci pro vsechny programy
+    // (programy maji blok CameraMatrices navazany na CameraUniformBinding, viz ShaderProgram)
+    void UpdateMatrix(float FOVdeg, float nearPlane, float farPlane, bool is2DMode)
+    {
+        glm::mat4 camMatrix = GetMatrix(FOVdeg, nearPlane, farPlane, is2DMode);
+        if (!UniformBuffer) {
+            glGenBuffers(1, &UniformBuffer);
+            bindBufferCached(GL_UNIFORM_BUFFER, UniformBuffer);
+            glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+            bindBufferBaseCached(GL_UNIFORM_BUFFER, CameraUniformBinding, UniformBuffer);
+        }
+        bindBufferCached(GL_UNIFORM_BUFFER, UniformBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(camMatrix));
     }
 
     // umoznuje ovladani kamery pomoci klavesnice
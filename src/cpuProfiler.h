@@ -0,0 +1,225 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ mereni casu useku kodu na CPU (zony), export do formatu Chrome trace (chrome://tracing, ui.perfetto.dev)
+ - CPU_ZONE("jmeno") zmeri cas od mista pouziti do konce bloku, jmeno musi byt retezcovy literal
+ - kazde vlakno zapisuje do vlastniho kruhoveho bufferu bez zamku, pri zaplneni se prepisuji nejstarsi zony
+ - buffer se alokuje az pri prvni zaznamenane zone vlakna a po skonceni vlakna ho prevezme dalsi vlakno
+   se stejnym jmenem, takze vlakna bez mereni nic nealokuji a opakovane spoustena vlakna (enkoder zaznamu)
+   buffery nehromadi
+ - vypnute zony stoji jedno cteni priznaku a podminku pri vstupu a jednu podminku pri vystupu,
+   proto mohou zustat v bezne sestavenem programu
+ - export cte buffery ostatnich vlaken za behu; kazda polozka ma poradove cislo (seqlock), takze se zona
+   rozpracovana nebo prepsana behem cteni pozna a vynecha
+*/
+
+// pocet zon v bufferu jednoho vlakna (mocnina dvou)
+const uint32_t CpuZoneRingSize = 1 << 16;
+
+// zona s indexem i ma sequence 2 * i + 1 behem zapisu a 2 * i + 2 po zapisu,
+// pole jsou atomicka (relaxed), aby soubezne cteni exportem nebylo datovym zavodem
+struct CpuZoneEvent
+{
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> beginNs{0};
+    std::atomic<int64_t> endNs{0};
+};
+
+// kruhovy buffer jednoho vlakna, zapisuje jen vlastnik, head zvysuje az po zapisu zony
+struct CpuZoneRing
+{
+    std::string threadName;
+    int threadIndex = 0;
+    std::atomic<uint64_t> head{0};
+    std::unique_ptr<CpuZoneEvent[]> events{new CpuZoneEvent[CpuZoneRingSize]};
+};
+
+struct CpuProfiler
+{
+    std::atomic<bool> enabled{false};
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    // buffery vsech vlaken, ktera kdy zaznamenala zonu (zustavaji i po skonceni vlakna kvuli exportu)
+    std::mutex ringsMutex;
+    std::vector<std::unique_ptr<CpuZoneRing>> rings;
+    // buffery skoncenych pojmenovanych vlaken, pouziji se pro dalsi vlakno se stejnym jmenem
+    std::vector<CpuZoneRing*> freeRings;
+};
+
+CpuProfiler& cpuProfiler()
+{
+    static CpuProfiler profiler;
+    return profiler;
+}
+
+bool cpuProfilerEnabled()
+{
+    return cpuProfiler().enabled.load(std::memory_order_relaxed);
+}
+
+void setCpuProfilerEnabled(bool enabled)
+{
+    cpuProfiler().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+int64_t cpuProfilerNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - cpuProfiler().epoch).count();
+}
+
+// stav vlakna: jmeno pro export a buffer od prvni zaznamenane zony, pojmenovane vlakno ho pri konci vrati
+struct CpuZoneThread
+{
+    std::string name;
+    CpuZoneRing* ring = nullptr;
+
+    ~CpuZoneThread()
+    {
+        if (ring && !name.empty()) {
+            CpuProfiler& profiler = cpuProfiler();
+            std::lock_guard<std::mutex> lock(profiler.ringsMutex);
+            profiler.freeRings.push_back(ring);
+        }
+    }
+};
+
+CpuZoneThread& cpuZoneThread()
+{
+    thread_local CpuZoneThread thread;
+    return thread;
+}
+
+// buffer volajiciho vlakna, zamyka se jen pri prvni zaznamenane zone ve vlakne
+CpuZoneRing& cpuZoneRing()
+{
+    CpuZoneThread& thread = cpuZoneThread();
+    if (!thread.ring) {
+        CpuProfiler& profiler = cpuProfiler();
+        std::lock_guard<std::mutex> lock(profiler.ringsMutex);
+        // starsi zony skonceneho vlakna v bufferu zustanou pod stejnym jmenem, head pokracuje dal
+        for (size_t i = 0; i < profiler.freeRings.size() && !thread.name.empty(); ++i) {
+            if (profiler.freeRings[i]->threadName == thread.name) {
+                thread.ring = profiler.freeRings[i];
+                profiler.freeRings.erase(profiler.freeRings.begin() + i);
+                break;
+            }
+        }
+        if (!thread.ring) {
+            profiler.rings.push_back(std::unique_ptr<CpuZoneRing>(new CpuZoneRing()));
+            thread.ring = profiler.rings.back().get();
+            thread.ring->threadIndex = static_cast<int>(profiler.rings.size());
+        }
+        thread.ring->threadName = thread.name.empty() ? "Thread " + std::to_string(thread.ring->threadIndex) : thread.name;
+    }
+    return *thread.ring;
+}
+
+// jmeno vlakna v exportu (vola se na zacatku vlakna), buffer se tim nealokuje
+void setCpuProfilerThreadName(const std::string& name)
+{
+    CpuZoneThread& thread = cpuZoneThread();
+    thread.name = name;
+    if (thread.ring) {
+        std::lock_guard<std::mutex> lock(cpuProfiler().ringsMutex);
+        thread.ring->threadName = name;
+    }
+}
+
+class CpuZone
+{
+    public:
+    explicit CpuZone(const char* zoneName) : name(zoneName)
+    {
+        if (cpuProfilerEnabled()) {
+            beginNs = cpuProfilerNowNs();
+            recording = true;
+        }
+    }
+
+    ~CpuZone()
+    {
+        if (!recording) {
+            return;
+        }
+        CpuZoneRing& ring = cpuZoneRing();
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        CpuZoneEvent& event = ring.events[head & (CpuZoneRingSize - 1)];
+        // liche poradove cislo pred zapisem poli, sude az po nem
+        event.sequence.store(2 * head + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        event.name.store(name, std::memory_order_relaxed);
+        event.beginNs.store(beginNs, std::memory_order_relaxed);
+        event.endNs.store(cpuProfilerNowNs(), std::memory_order_relaxed);
+        event.sequence.store(2 * head + 2, std::memory_order_release);
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    CpuZone(const CpuZone&) = delete;
+    CpuZone& operator=(const CpuZone&) = delete;
+
+    private:
+    const char* name;
+    int64_t beginNs = 0;
+    bool recording = false;
+};
+
+#define CPU_ZONE_CONCAT_INNER(a, b) a##b
+#define CPU_ZONE_CONCAT(a, b) CPU_ZONE_CONCAT_INNER(a, b)
+#define CPU_ZONE(name) CpuZone CPU_ZONE_CONCAT(cpuZone, __LINE__)(name)
+
+// zapise zony ze vsech vlaken jako JSON pro chrome://tracing nebo ui.perfetto.dev, vrati pocet zon
+int writeCpuTrace(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Unable to write trace: " << path << "\n";
+        return -1;
+    }
+    CpuProfiler& profiler = cpuProfiler();
+    std::lock_guard<std::mutex> lock(profiler.ringsMutex);
+
+    int written = 0;
+    const char* separator = "\n";
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (const auto& ring : profiler.rings) {
+        file << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadIndex
+             << ",\"args\":{\"name\":\"" << ring->threadName << "\"}}";
+        separator = ",\n";
+
+        // zona i je platna, jen pokud ma pred i po precteni poli poradove cislo 2 * i + 2
+        // (jinak ji vlakno prave zapisuje nebo uz ji prepsalo novejsi zonou)
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t first = head > CpuZoneRingSize ? head - CpuZoneRingSize : 0;
+        for (uint64_t i = first; i < head; ++i) {
+            const CpuZoneEvent& event = ring->events[i & (CpuZoneRingSize - 1)];
+            if (event.sequence.load(std::memory_order_acquire) != 2 * i + 2) {
+                continue;
+            }
+            const char* name = event.name.load(std::memory_order_relaxed);
+            int64_t beginNs = event.beginNs.load(std::memory_order_relaxed);
+            int64_t endNs = event.endNs.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (event.sequence.load(std::memory_order_relaxed) != 2 * i + 2) {
+                continue;
+            }
+            // casy v mikrosekundach
+            file << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->threadIndex
+                 << ",\"ts\":" << beginNs / 1000.0 << ",\"dur\":" << (endNs - beginNs) / 1000.0 << "}";
+            written++;
+        }
+    }
+    file << "\n]}\n";
+    std::cout << "Wrote " << written << " CPU zones to " << path << "\n";
+    return written;
+}
@@ -61,17 +61,18 @@ std::vector<unsigned int> generateCubeIndices()
 
 std::vector<unsigned int> handleCubeIntoBuffers(const std::vector<float>& vertices, const std::vector<unsigned int>& indices) 
 {
-    unsigned int VBO_cube, EBO_cube;
+    unsigned int VBO_cube, EBO_cube, VBO_instances;
     glGenBuffers(1, &VBO_cube);
     glGenBuffers(1, &EBO_cube);
+    glGenBuffers(1, &VBO_instances);
 
     unsigned int VAO_cube;
     glGenVertexArrays(1, &VAO_cube);
 
-    glBindVertexArray(VAO_cube);
+    bindVertexArrayCached(VAO_cube);
 
     // predani vrcholku do VBO
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_cube);
+    bindBufferCached(GL_ARRAY_BUFFER, VBO_cube);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
 
     // pozice = layout 0
@@ -82,15 +83,22 @@ std::vector<unsigned int> handleCubeIntoBuffers(const std::vector<float>& vertic
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
+    // posun a meritko kazde instance krychle = layout 2, meni se az po kazde instanci
+    bindBufferCached(GL_ARRAY_BUFFER, VBO_instances);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
     // provadi vykresleni pomoci indexu
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_cube);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
 
-    glBindVertexArray(0);
+    bindVertexArrayCached(0);
 
     std::vector<unsigned int> buffers;
     buffers.push_back(VAO_cube);
     buffers.push_back(VBO_cube);
     buffers.push_back(EBO_cube);
+    buffers.push_back(VBO_instances);
     return buffers;
 }
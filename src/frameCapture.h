@@ -0,0 +1,262 @@
+#pragma once
+#include "glad.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cpuProfiler.h"
+#include "glState.h"
+#include "headless.h"
+
+/*
+ nahravani snimku bez cekani na GPU
+ - glReadPixels zapisuje do jednoho z FrameCaptureSlots pixel bufferu (PBO) a hned se vrati,
+   data se namapuji az o nekolik snimku pozdeji, kdy fence ukaze, ze kopie na GPU skoncila
+ - prevod a zapis na disk dela vlakno kodovani, hlavni smycka jen kopiruje hotove snimky do fronty
+ - vystup podle pripony: .y4m = jeden soubor YUV4MPEG2 (4:4:4), jinak sekvence <cesta>_NNNNN.ppm
+ - kdyz kodovani nestiha, hlavni smycka pocka (nahravka je vzdy uplna)
+*/
+
+const int FrameCaptureSlots = 3;
+// maximalni pocet snimku cekajicich na zapis
+const size_t FrameCaptureQueueLimit = 8;
+
+struct FrameCapture
+{
+    bool active = false;
+    bool y4m = false;
+    std::string path;
+    int width = 0;
+    int height = 0;
+    int fps = 60;
+
+    unsigned int pixelBuffers[FrameCaptureSlots] = {};
+    GLsync fences[FrameCaptureSlots] = {};
+    int nextSlot = 0;
+    int framesRead = 0;
+    // zapisuje vlakno kodovani
+    std::atomic<int> framesWritten{0};
+    // cas hlavni smycky v captureFrame (ms) pro zobrazeni v menu
+    double lastCaptureMs = 0.0;
+
+    std::thread encoder;
+    std::mutex mutex;
+    std::condition_variable queueChanged;
+    std::deque<std::vector<unsigned char>> queue;
+    std::vector<std::vector<unsigned char>> freeFrames;
+    bool stopping = false;
+    std::ofstream output;
+};
+
+// RGBA radky zdola nahoru -> RGB shora dolu (PPM) nebo roviny Y, Cb, Cr shora dolu (Y4M)
+void encodeCapturedFrame(FrameCapture& capture, const std::vector<unsigned char>& rgba, std::vector<unsigned char>& converted)
+{
+    CPU_ZONE("encodeCapturedFrame");
+    const int w = capture.width;
+    const int h = capture.height;
+    if (!capture.y4m) {
+        converted.resize(static_cast<size_t>(w) * h * 3);
+        for (size_t i = 0, n = static_cast<size_t>(w) * h; i < n; ++i) {
+            converted[i * 3] = rgba[i * 4];
+            converted[i * 3 + 1] = rgba[i * 4 + 1];
+            converted[i * 3 + 2] = rgba[i * 4 + 2];
+        }
+        char index[16];
+        std::snprintf(index, sizeof(index), "_%05d", capture.framesWritten.load());
+        writeFramePpm(capture.path + index + ".ppm", w, h, converted.data());
+        return;
+    }
+
+    // BT.601, omezeny rozsah (16-235)
+    const size_t plane = static_cast<size_t>(w) * h;
+    converted.resize(plane * 3);
+    for (int y = 0; y < h; ++y) {
+        const unsigned char* src = &rgba[static_cast<size_t>(h - 1 - y) * w * 4];
+        for (int x = 0; x < w; ++x) {
+            int r = src[x * 4];
+            int g = src[x * 4 + 1];
+            int b = src[x * 4 + 2];
+            size_t k = static_cast<size_t>(y) * w + x;
+            converted[k] = static_cast<unsigned char>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            converted[plane + k] = static_cast<unsigned char>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            converted[2 * plane + k] = static_cast<unsigned char>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+    capture.output << "FRAME\n";
+    capture.output.write(reinterpret_cast<const char*>(converted.data()), converted.size());
+}
+
+void runFrameCaptureEncoder(FrameCapture* capture)
+{
+    setCpuProfilerThreadName("Frame encoder");
+    std::vector<unsigned char> converted;
+    while (true) {
+        std::vector<unsigned char> frame;
+        {
+            std::unique_lock<std::mutex> lock(capture->mutex);
+            capture->queueChanged.wait(lock, [&] { return !capture->queue.empty() || capture->stopping; });
+            if (capture->queue.empty()) {
+                return;
+            }
+            frame = std::move(capture->queue.front());
+            capture->queue.pop_front();
+        }
+        encodeCapturedFrame(*capture, frame, converted);
+        {
+            std::lock_guard<std::mutex> lock(capture->mutex);
+            capture->framesWritten++;
+            capture->freeFrames.push_back(std::move(frame));
+        }
+        capture->queueChanged.notify_all();
+    }
+}
+
+// zacne nahravat snimky width x height do path (.y4m nebo prefix PPM sekvence)
+bool startFrameCapture(FrameCapture& capture, const std::string& path, int width, int height, int fps = 60)
+{
+    capture.path = path;
+    capture.width = width;
+    capture.height = height;
+    capture.fps = fps;
+    capture.y4m = path.size() > 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+    capture.nextSlot = 0;
+    capture.framesRead = 0;
+    capture.framesWritten = 0;
+    capture.stopping = false;
+
+    if (capture.y4m) {
+        capture.output.open(path, std::ios::binary);
+        if (!capture.output) {
+            std::cerr << "Unable to write capture: " << path << "\n";
+            return false;
+        }
+        capture.output << "YUV4MPEG2 W" << width << " H" << height << " F" << fps << ":1 Ip A1:1 C444\n";
+    }
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * 4;
+    glGenBuffers(FrameCaptureSlots, capture.pixelBuffers);
+    for (int i = 0; i < FrameCaptureSlots; ++i) {
+        bindBufferCached(GL_PIXEL_PACK_BUFFER, capture.pixelBuffers[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    }
+    bindBufferCached(GL_PIXEL_PACK_BUFFER, 0);
+
+    capture.encoder = std::thread(runFrameCaptureEncoder, &capture);
+    capture.active = true;
+    return true;
+}
+
+// zkopiruje hotovy snimek ze slotu do fronty kodovani; wait = pockat na GPU (bez omezeni), jinak jen pokud uz je hotovy
+// po navratu s wait nebo s true uz slot nema fence a muze se znovu pouzit
+bool collectCaptureSlot(FrameCapture& capture, int slot, bool wait)
+{
+    GLsync& fence = capture.fences[slot];
+    if (!fence) {
+        return false;
+    }
+    GLenum result = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000000 : 0);
+    while (wait && result == GL_TIMEOUT_EXPIRED) {
+        result = glClientWaitSync(fence, 0, 1000000000);
+    }
+    if (result == GL_TIMEOUT_EXPIRED) {
+        return false;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+    if (result == GL_WAIT_FAILED) {
+        std::cerr << "Frame capture: waiting for a frame failed, frame dropped\n";
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(capture.width) * capture.height * 4;
+    std::vector<unsigned char> frame;
+    {
+        // kdyz kodovani nestiha, pocka se na misto ve fronte
+        std::unique_lock<std::mutex> lock(capture.mutex);
+        capture.queueChanged.wait(lock, [&] { return capture.queue.size() < FrameCaptureQueueLimit; });
+        if (!capture.freeFrames.empty()) {
+            frame = std::move(capture.freeFrames.back());
+            capture.freeFrames.pop_back();
+        }
+    }
+    frame.resize(size);
+
+    bindBufferCached(GL_PIXEL_PACK_BUFFER, capture.pixelBuffers[slot]);
+    const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (pixels) {
+        std::copy(static_cast<const unsigned char*>(pixels), static_cast<const unsigned char*>(pixels) + size, frame.begin());
+    }
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    bindBufferCached(GL_PIXEL_PACK_BUFFER, 0);
+
+    {
+        std::lock_guard<std::mutex> lock(capture.mutex);
+        capture.queue.push_back(std::move(frame));
+    }
+    capture.queueChanged.notify_all();
+    return true;
+}
+
+// vola se po vykresleni snimku pred prohozenim bufferu, cte aktualni read framebuffer
+void captureFrame(FrameCapture& capture)
+{
+    if (!capture.active) {
+        return;
+    }
+    CPU_ZONE("captureFrame");
+    auto start = std::chrono::steady_clock::now();
+
+    // starsi snimky presne v poradi, v jakem byly precteny: na nejstarsi se pocka, protoze se jeho slot
+    // ted znovu pouzije, novejsi se vezmou jen dokud jsou hotove
+    collectCaptureSlot(capture, capture.nextSlot, true);
+    for (int i = 1; i < FrameCaptureSlots; ++i) {
+        if (!collectCaptureSlot(capture, (capture.nextSlot + i) % FrameCaptureSlots, false)) {
+            break;
+        }
+    }
+
+    int slot = capture.nextSlot;
+    bindBufferCached(GL_PIXEL_PACK_BUFFER, capture.pixelBuffers[slot]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, capture.width, capture.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    bindBufferCached(GL_PIXEL_PACK_BUFFER, 0);
+    capture.fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    capture.nextSlot = (slot + 1) % FrameCaptureSlots;
+    capture.framesRead++;
+
+    capture.lastCaptureMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// dopise vsechny rozpracovane snimky a ukonci vlakno kodovani
+void stopFrameCapture(FrameCapture& capture)
+{
+    if (!capture.active) {
+        return;
+    }
+    // od nejstarsiho, kazde cekani skonci az s hotovym snimkem, takze nezustane zadny fence
+    for (int i = 0; i < FrameCaptureSlots; ++i) {
+        collectCaptureSlot(capture, (capture.nextSlot + i) % FrameCaptureSlots, true);
+    }
+    {
+        std::lock_guard<std::mutex> lock(capture.mutex);
+        capture.stopping = true;
+    }
+    capture.queueChanged.notify_all();
+    capture.encoder.join();
+
+    glDeleteBuffers(FrameCaptureSlots, capture.pixelBuffers);
+    if (capture.output.is_open()) {
+        capture.output.close();
+    }
+    capture.queue.clear();
+    capture.freeFrames.clear();
+    capture.active = false;
+}
@@ -0,0 +1,196 @@
+#pragma once
+#include "imgui.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+ statistika casu snimku v klouzavem okne (io.Framerate je prumer a spicky v nem zaniknou)
+ - frame = cas mezi zacatky dvou snimku, CPU = cas od zacatku snimku do odeslani (pred prohozenim bufferu),
+   GPU = prubeh Frame z gpuProfiler.h (jen kdyz se meri, patri o jeden snimek starsimu snimku)
+ - percentily metodou nejblizsiho poradi, pocitaji se jen pri zobrazeni nebo exportu
+ - zaseknuti (hitch) je snimek delsi nez hitchThresholdMs
+*/
+
+const int FrameStatsWindow = 600;
+
+struct FrameStats
+{
+    // kruhove okno, zaporny cas GPU = nezmereno
+    float frameMs[FrameStatsWindow] = {};
+    float cpuMs[FrameStatsWindow] = {};
+    float gpuMs[FrameStatsWindow] = {};
+    int count = 0;
+    int offset = 0;
+    long long totalFrames = 0;
+    long long totalHitches = 0;
+    float hitchThresholdMs = 33.3f;
+
+    std::chrono::steady_clock::time_point frameStart;
+    bool started = false;
+    float submitMs = 0.0f;
+};
+
+struct FrameStatsSummary
+{
+    int samples = 0;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+};
+
+// na zacatku snimku: ulozi predchozi snimek (gpuMs < 0, pokud se GPU nemeri)
+void beginFrameStats(FrameStats& stats, float gpuMs)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (stats.started) {
+        float frameMs = std::chrono::duration<float, std::milli>(now - stats.frameStart).count();
+        stats.frameMs[stats.offset] = frameMs;
+        stats.cpuMs[stats.offset] = stats.submitMs;
+        stats.gpuMs[stats.offset] = gpuMs;
+        stats.offset = (stats.offset + 1) % FrameStatsWindow;
+        stats.count = std::min(stats.count + 1, FrameStatsWindow);
+        stats.totalFrames++;
+        if (frameMs > stats.hitchThresholdMs) {
+            stats.totalHitches++;
+        }
+    }
+    stats.frameStart = now;
+    stats.started = true;
+}
+
+// pred cekanim na udalost (vykreslovani na vyzadani): cekani neni cas snimku, posledni snimek se nezapocita
+void pauseFrameStats(FrameStats& stats)
+{
+    stats.started = false;
+}
+
+// po odeslani vsech prikazu snimku (pred prohozenim bufferu)
+void endFrameStatsSubmit(FrameStats& stats)
+{
+    stats.submitMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - stats.frameStart).count();
+}
+
+// i-ty nejstarsi vzorek okna
+int frameStatsIndex(const FrameStats& stats, int i)
+{
+    return (stats.offset - stats.count + i + FrameStatsWindow) % FrameStatsWindow;
+}
+
+FrameStatsSummary summarizeFrameTimes(const FrameStats& stats, const float* times)
+{
+    std::vector<float> sorted;
+    sorted.reserve(stats.count);
+    for (int i = 0; i < stats.count; ++i) {
+        float value = times[frameStatsIndex(stats, i)];
+        if (value >= 0.0f) {
+            sorted.push_back(value);
+        }
+    }
+    FrameStatsSummary summary;
+    summary.samples = static_cast<int>(sorted.size());
+    if (sorted.empty()) {
+        return summary;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](float p) {
+        int rank = static_cast<int>(std::ceil(p * sorted.size()));
+        return sorted[std::max(rank, 1) - 1];
+    };
+    summary.p50 = percentile(0.50f);
+    summary.p95 = percentile(0.95f);
+    summary.p99 = percentile(0.99f);
+    summary.max = sorted.back();
+    return summary;
+}
+
+int frameStatsWindowHitches(const FrameStats& stats)
+{
+    int hitches = 0;
+    for (int i = 0; i < stats.count; ++i) {
+        if (stats.frameMs[frameStatsIndex(stats, i)] > stats.hitchThresholdMs) {
+            hitches++;
+        }
+    }
+    return hitches;
+}
+
+// zapise okno od nejstarsiho snimku, chybejici cas GPU jako prazdna hodnota
+bool writeFrameStatsCsv(const FrameStats& stats, const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Unable to write frame statistics: " << path << "\n";
+        return false;
+    }
+    file << "frame,frame_ms,cpu_ms,gpu_ms\n";
+    long long firstFrame = stats.totalFrames - stats.count;
+    for (int i = 0; i < stats.count; ++i) {
+        int k = frameStatsIndex(stats, i);
+        file << firstFrame + i << "," << stats.frameMs[k] << "," << stats.cpuMs[k] << ",";
+        if (stats.gpuMs[k] >= 0.0f) {
+            file << stats.gpuMs[k];
+        }
+        file << "\n";
+    }
+    return true;
+}
+
+void printFrameStatsSummary(const FrameStats& stats)
+{
+    FrameStatsSummary frame = summarizeFrameTimes(stats, stats.frameMs);
+    std::printf("Frame time over %d frames: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms, %d hitches > %.1f ms\n",
+                frame.samples, frame.p50, frame.p95, frame.p99, frame.max, frameStatsWindowHitches(stats),
+                stats.hitchThresholdMs);
+}
+
+void drawFrameStatsRow(const char* label, const FrameStatsSummary& summary)
+{
+    if (summary.samples == 0) {
+        ImGui::Text("%-6s not measured", label);
+        return;
+    }
+    ImGui::Text("%-6s p50 %6.2f  p95 %6.2f  p99 %6.2f  max %6.2f", label, summary.p50, summary.p95, summary.p99,
+                summary.max);
+}
+
+// panel v okne Settings
+void drawFrameStats(FrameStats& stats, const std::string& csvPath)
+{
+    FrameStatsSummary frame = summarizeFrameTimes(stats, stats.frameMs);
+    ImGui::Text("Last %d frames (ms):", stats.count);
+    drawFrameStatsRow("Frame", frame);
+    drawFrameStatsRow("CPU", summarizeFrameTimes(stats, stats.cpuMs));
+    drawFrameStatsRow("GPU", summarizeFrameTimes(stats, stats.gpuMs));
+    ImGui::SliderFloat("Hitch threshold (ms)", &stats.hitchThresholdMs, 5.0f, 100.0f, "%.1f");
+    ImGui::Text("Hitches: %d in window, %lld total", frameStatsWindowHitches(stats), stats.totalHitches);
+
+    if (stats.count > 0) {
+        // prubeh v case a histogram (30 sloupcu od 0 do maxima)
+        std::vector<float> ordered(stats.count);
+        for (int i = 0; i < stats.count; ++i) {
+            ordered[i] = stats.frameMs[frameStatsIndex(stats, i)];
+        }
+        ImGui::PlotLines("Frame time", ordered.data(), stats.count, 0, nullptr, 0.0f, frame.max, ImVec2(0, 50));
+        const int bins = 30;
+        float histogram[bins] = {};
+        for (float value : ordered) {
+            int bin = std::min(bins - 1, static_cast<int>(value / std::max(frame.max, 0.001f) * bins));
+            histogram[bin] += 1.0f;
+        }
+        char overlay[32];
+        std::snprintf(overlay, sizeof(overlay), "0 - %.1f ms", frame.max);
+        ImGui::PlotHistogram("Histogram", histogram, bins, 0, overlay, 0.0f, FLT_MAX, ImVec2(0, 50));
+    }
+
+    if (ImGui::Button(("Export " + csvPath).c_str())) {
+        writeFrameStatsCsv(stats, csvPath);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "glad.h"
+#include "imgui.h"
+#include <cstdio>
+
+/*
+ pocty volani OpenGL za snimek (kresleni, nahravani dat, zmeny stavu)
+ - citace jsou v glad.c a zapinaji se CMake volbou BEZIER_GL_COUNTERS (definuje GLAD_GL_COUNTERS),
+   bez ni se nic nepocita a panel jen ukaze, jak je zapnout
+ - pocita se kazde volani, ktere projde do ovladace (vazby preskocene cache v glState.h ne)
+*/
+
+#ifdef GLAD_GL_COUNTERS
+// hodnoty posledniho dokonceneho snimku
+gladGLcountersStruct& lastFrameGlCounters()
+{
+    static gladGLcountersStruct counters = {};
+    return counters;
+}
+#endif
+
+// na zacatku snimku: ulozi citace predchoziho snimku a vynuluje je
+void beginGlCountersFrame()
+{
+#ifdef GLAD_GL_COUNTERS
+    lastFrameGlCounters() = GLCounters;
+    GLCounters = {};
+#endif
+}
+
+void printGlCounters()
+{
+#ifdef GLAD_GL_COUNTERS
+    const gladGLcountersStruct& c = lastFrameGlCounters();
+    std::printf("Last frame: %llu draws, %llu instanced (%llu instances), %llu indirect (%llu commands), "
+                "%llu uploads (%llu bytes), %llu programs, %llu VAOs, %llu buffer binds, %llu uniforms\n",
+                c.drawCalls, c.instancedDraws, c.instances, c.indirectDraws, c.indirectCommands, c.uploadCalls,
+                c.uploadBytes, c.programSwitches, c.vertexArrayBinds, c.bufferBinds, c.uniformUpdates);
+#endif
+}
+
+// panel v okne Settings
+void drawGlCounters()
+{
+#ifdef GLAD_GL_COUNTERS
+    const gladGLcountersStruct& c = lastFrameGlCounters();
+    ImGui::Text("Draw calls:       %llu", c.drawCalls);
+    ImGui::Text("Instanced draws:  %llu (%llu instances)", c.instancedDraws, c.instances);
+    ImGui::Text("Indirect draws:   %llu (%llu commands)", c.indirectDraws, c.indirectCommands);
+    ImGui::Text("Buffer uploads:   %llu (%.1f KB)", c.uploadCalls, c.uploadBytes / 1024.0);
+    ImGui::Text("Program switches: %llu", c.programSwitches);
+    ImGui::Text("VAO binds:        %llu", c.vertexArrayBinds);
+    ImGui::Text("Buffer binds:     %llu", c.bufferBinds);
+    ImGui::Text("Uniform updates:  %llu", c.uniformUpdates);
+#else
+    ImGui::TextWrapped("Counting is disabled, configure with -DBEZIER_GL_COUNTERS=ON.");
+#endif
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "glad.h"
+
+/*
+ cache aktualne navazaneho programu, VAO a bufferu, vazby na stejny objekt se do ovladace neposilaji
+ - vsechny vazby v programu musi jit pres tyto funkce, jinak cache neodpovida skutecnemu stavu
+ - GL_ELEMENT_ARRAY_BUFFER je soucasti VAO, nastavuje se jen pri tvorbe VAO a necachuje se
+ - vykreslovani po sobe VAO neodvazuje (glBindVertexArray(0)), dalsi kresleni si navaze svoje
+ - kod mimo cache (ImGui) muze stav zmenit, proto se cache kazdy snimek zneplatni (resetGlStateCache)
+*/
+
+// hodnota pro neznamy stav, prvni vazba po zneplatneni se vzdy posle
+const unsigned int GlStateUnknown = ~0u;
+
+struct GlStateCache
+{
+    unsigned int program = GlStateUnknown;
+    unsigned int vertexArray = GlStateUnknown;
+    unsigned int arrayBuffer = GlStateUnknown;
+    unsigned int uniformBuffer = GlStateUnknown;
+    unsigned int shaderStorageBuffer = GlStateUnknown;
+    unsigned int drawIndirectBuffer = GlStateUnknown;
+};
+
+GlStateCache& glStateCache()
+{
+    static GlStateCache cache;
+    return cache;
+}
+
+void resetGlStateCache()
+{
+    glStateCache() = GlStateCache();
+}
+
+// polozka cache pro cil bufferu (nullptr pro cile, ktere se necachuji)
+unsigned int* glStateBufferSlot(GLenum target)
+{
+    GlStateCache& cache = glStateCache();
+    switch (target) {
+        case GL_ARRAY_BUFFER: return &cache.arrayBuffer;
+        case GL_UNIFORM_BUFFER: return &cache.uniformBuffer;
+        case GL_SHADER_STORAGE_BUFFER: return &cache.shaderStorageBuffer;
+        case GL_DRAW_INDIRECT_BUFFER: return &cache.drawIndirectBuffer;
+        default: return nullptr;
+    }
+}
+
+void useProgramCached(unsigned int program)
+{
+    GlStateCache& cache = glStateCache();
+    if (cache.program != program) {
+        glUseProgram(program);
+        cache.program = program;
+    }
+}
+
+void bindVertexArrayCached(unsigned int vertexArray)
+{
+    GlStateCache& cache = glStateCache();
+    if (cache.vertexArray != vertexArray) {
+        glBindVertexArray(vertexArray);
+        cache.vertexArray = vertexArray;
+    }
+}
+
+void bindBufferCached(GLenum target, unsigned int buffer)
+{
+    unsigned int* slot = glStateBufferSlot(target);
+    if (!slot) {
+        glBindBuffer(target, buffer);
+    } else if (*slot != buffer) {
+        glBindBuffer(target, buffer);
+        *slot = buffer;
+    }
+}
+
+// glBindBufferBase navaze buffer i na obecny cil, cache se musi aktualizovat
+void bindBufferBaseCached(GLenum target, unsigned int index, unsigned int buffer)
+{
+    glBindBufferBase(target, index, buffer);
+    unsigned int* slot = glStateBufferSlot(target);
+    if (slot) {
+        *slot = buffer;
+    }
+}
+
+// smazany buffer se ze vsech vazeb odvaze, cache to musi vedet (jmeno muze dostat novy buffer)
+void deleteBufferCached(unsigned int buffer)
+{
+    glDeleteBuffers(1, &buffer);
+    GlStateCache& cache = glStateCache();
+    unsigned int* slots[] = { &cache.arrayBuffer, &cache.uniformBuffer, &cache.shaderStorageBuffer, &cache.drawIndirectBuffer };
+    for (unsigned int* slot : slots) {
+        if (*slot == buffer) {
+            *slot = 0;
+        }
+    }
+}
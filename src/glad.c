@@ -7,6 +7,13 @@
     APIs: gl=3.3
     Profile: core
     Extensions:
+        GL_ARB_buffer_storage,
+        GL_ARB_compute_shader,
+        GL_ARB_draw_indirect,
+        GL_ARB_multi_draw_indirect,
+        GL_ARB_shader_image_load_store,
+        GL_ARB_shader_storage_buffer_object,
+        GL_ARB_tessellation_shader
         
     Loader: True
     Local files: False
@@ -14,9 +21,9 @@
     Reproducible: False
 
     Commandline:
-        --profile="core" --api="gl=3.3" --generator="c" --spec="gl" --extensions=""
+        --profile="core" --api="gl=3.3" --generator="c" --spec="gl" --extensions="GL_ARB_buffer_storage,GL_ARB_compute_shader,GL_ARB_draw_indirect,GL_ARB_multi_draw_indirect,GL_ARB_shader_image_load_store,GL_ARB_shader_storage_buffer_object,GL_ARB_tessellation_shader"
     Online:
-        https://glad.dav1d.de/#profile=core&language=c&specification=gl&loader=on&api=gl%3D3.3
+        https://glad.dav1d.de/#profile=core&language=c&specification=gl&loader=on&api=gl%3D3.3&extensions=GL_ARB_buffer_storage&extensions=GL_ARB_compute_shader&extensions=GL_ARB_draw_indirect&extensions=GL_ARB_multi_draw_indirect&extensions=GL_ARB_shader_image_load_store&extensions=GL_ARB_shader_storage_buffer_object&extensions=GL_ARB_tessellation_shader
 */
 
 #include <stdio.h>
@@ -641,6 +648,25 @@ PFNGLVERTEXP4UIPROC glad_glVertexP4ui = NULL;
 PFNGLVERTEXP4UIVPROC glad_glVertexP4uiv = NULL;
 PFNGLVIEWPORTPROC glad_glViewport = NULL;
 PFNGLWAITSYNCPROC glad_glWaitSync = NULL;
+int GLAD_GL_ARB_buffer_storage = 0;
+PFNGLBUFFERSTORAGEPROC glad_glBufferStorage = NULL;
+int GLAD_GL_ARB_compute_shader = 0;
+PFNGLDISPATCHCOMPUTEPROC glad_glDispatchCompute = NULL;
+PFNGLDISPATCHCOMPUTEINDIRECTPROC glad_glDispatchComputeIndirect = NULL;
+int GLAD_GL_ARB_draw_indirect = 0;
+PFNGLDRAWARRAYSINDIRECTPROC glad_glDrawArraysIndirect = NULL;
+PFNGLDRAWELEMENTSINDIRECTPROC glad_glDrawElementsIndirect = NULL;
+int GLAD_GL_ARB_multi_draw_indirect = 0;
+PFNGLMULTIDRAWARRAYSINDIRECTPROC glad_glMultiDrawArraysIndirect = NULL;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC glad_glMultiDrawElementsIndirect = NULL;
+int GLAD_GL_ARB_shader_image_load_store = 0;
+PFNGLBINDIMAGETEXTUREPROC glad_glBindImageTexture = NULL;
+PFNGLMEMORYBARRIERPROC glad_glMemoryBarrier = NULL;
+int GLAD_GL_ARB_shader_storage_buffer_object = 0;
+PFNGLSHADERSTORAGEBLOCKBINDINGPROC glad_glShaderStorageBlockBinding = NULL;
+int GLAD_GL_ARB_tessellation_shader = 0;
+PFNGLPATCHPARAMETERIPROC glad_glPatchParameteri = NULL;
+PFNGLPATCHPARAMETERFVPROC glad_glPatchParameterfv = NULL;
 static void load_GL_VERSION_1_0(GLADloadproc load) {
 	if(!GLAD_GL_VERSION_1_0) return;
 	glad_glCullFace = (PFNGLCULLFACEPROC)load("glCullFace");
@@ -1054,8 +1080,48 @@ static void load_GL_VERSION_3_3(GLADloadproc load) {
 	glad_glSecondaryColorP3ui = (PFNGLSECONDARYCOLORP3UIPROC)load("glSecondaryColorP3ui");
 	glad_glSecondaryColorP3uiv = (PFNGLSECONDARYCOLORP3UIVPROC)load("glSecondaryColorP3uiv");
 }
+static void load_GL_ARB_buffer_storage(GLADloadproc load) {
+	if(!GLAD_GL_ARB_buffer_storage) return;
+	glad_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage");
+}
+static void load_GL_ARB_compute_shader(GLADloadproc load) {
+	if(!GLAD_GL_ARB_compute_shader) return;
+	glad_glDispatchCompute = (PFNGLDISPATCHCOMPUTEPROC)load("glDispatchCompute");
+	glad_glDispatchComputeIndirect = (PFNGLDISPATCHCOMPUTEINDIRECTPROC)load("glDispatchComputeIndirect");
+}
+static void load_GL_ARB_draw_indirect(GLADloadproc load) {
+	if(!GLAD_GL_ARB_draw_indirect) return;
+	glad_glDrawArraysIndirect = (PFNGLDRAWARRAYSINDIRECTPROC)load("glDrawArraysIndirect");
+	glad_glDrawElementsIndirect = (PFNGLDRAWELEMENTSINDIRECTPROC)load("glDrawElementsIndirect");
+}
+static void load_GL_ARB_multi_draw_indirect(GLADloadproc load) {
+	if(!GLAD_GL_ARB_multi_draw_indirect) return;
+	glad_glMultiDrawArraysIndirect = (PFNGLMULTIDRAWARRAYSINDIRECTPROC)load("glMultiDrawArraysIndirect");
+	glad_glMultiDrawElementsIndirect = (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)load("glMultiDrawElementsIndirect");
+}
+static void load_GL_ARB_shader_image_load_store(GLADloadproc load) {
+	if(!GLAD_GL_ARB_shader_image_load_store) return;
+	glad_glBindImageTexture = (PFNGLBINDIMAGETEXTUREPROC)load("glBindImageTexture");
+	glad_glMemoryBarrier = (PFNGLMEMORYBARRIERPROC)load("glMemoryBarrier");
+}
+static void load_GL_ARB_shader_storage_buffer_object(GLADloadproc load) {
+	if(!GLAD_GL_ARB_shader_storage_buffer_object) return;
+	glad_glShaderStorageBlockBinding = (PFNGLSHADERSTORAGEBLOCKBINDINGPROC)load("glShaderStorageBlockBinding");
+}
+static void load_GL_ARB_tessellation_shader(GLADloadproc load) {
+	if(!GLAD_GL_ARB_tessellation_shader) return;
+	glad_glPatchParameteri = (PFNGLPATCHPARAMETERIPROC)load("glPatchParameteri");
+	glad_glPatchParameterfv = (PFNGLPATCHPARAMETERFVPROC)load("glPatchParameterfv");
+}
 static int find_extensionsGL(void) {
 	if (!get_exts()) return 0;
+	GLAD_GL_ARB_buffer_storage = has_ext("GL_ARB_buffer_storage");
+	GLAD_GL_ARB_compute_shader = has_ext("GL_ARB_compute_shader");
+	GLAD_GL_ARB_draw_indirect = has_ext("GL_ARB_draw_indirect");
+	GLAD_GL_ARB_multi_draw_indirect = has_ext("GL_ARB_multi_draw_indirect");
+	GLAD_GL_ARB_shader_image_load_store = has_ext("GL_ARB_shader_image_load_store");
+	GLAD_GL_ARB_shader_storage_buffer_object = has_ext("GL_ARB_shader_storage_buffer_object");
+	GLAD_GL_ARB_tessellation_shader = has_ext("GL_ARB_tessellation_shader");
 	(void)&has_ext;
 	free_exts();
 	return 1;
@@ -1115,6 +1181,150 @@ static void find_coreGL(void) {
 	}
 }
 
+#ifdef GLAD_GL_COUNTERS
+/*
+   citace volani OpenGL: nahrane ukazatele se nahradi funkcemi, ktere zvysi citac
+   a zavolaji puvodni funkci (ImGui ma vlastni loader, jeho volani se nepocitaji)
+*/
+struct gladGLcountersStruct GLCounters = { 0 };
+
+static PFNGLDRAWARRAYSPROC glad_counted_glDrawArrays = NULL;
+static void APIENTRY glad_count_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+	GLCounters.drawCalls++;
+	glad_counted_glDrawArrays(mode, first, count);
+}
+static PFNGLDRAWELEMENTSPROC glad_counted_glDrawElements = NULL;
+static void APIENTRY glad_count_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+	GLCounters.drawCalls++;
+	glad_counted_glDrawElements(mode, count, type, indices);
+}
+static PFNGLDRAWARRAYSINSTANCEDPROC glad_counted_glDrawArraysInstanced = NULL;
+static void APIENTRY glad_count_glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {
+	GLCounters.instancedDraws++;
+	GLCounters.instances += instancecount;
+	glad_counted_glDrawArraysInstanced(mode, first, count, instancecount);
+}
+static PFNGLDRAWELEMENTSINSTANCEDPROC glad_counted_glDrawElementsInstanced = NULL;
+static void APIENTRY glad_count_glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount) {
+	GLCounters.instancedDraws++;
+	GLCounters.instances += instancecount;
+	glad_counted_glDrawElementsInstanced(mode, count, type, indices, instancecount);
+}
+static PFNGLDRAWARRAYSINDIRECTPROC glad_counted_glDrawArraysIndirect = NULL;
+static void APIENTRY glad_count_glDrawArraysIndirect(GLenum mode, const void *indirect) {
+	GLCounters.indirectDraws++;
+	GLCounters.indirectCommands++;
+	glad_counted_glDrawArraysIndirect(mode, indirect);
+}
+static PFNGLDRAWELEMENTSINDIRECTPROC glad_counted_glDrawElementsIndirect = NULL;
+static void APIENTRY glad_count_glDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect) {
+	GLCounters.indirectDraws++;
+	GLCounters.indirectCommands++;
+	glad_counted_glDrawElementsIndirect(mode, type, indirect);
+}
+static PFNGLMULTIDRAWARRAYSINDIRECTPROC glad_counted_glMultiDrawArraysIndirect = NULL;
+static void APIENTRY glad_count_glMultiDrawArraysIndirect(GLenum mode, const void *indirect, GLsizei drawcount, GLsizei stride) {
+	GLCounters.indirectDraws++;
+	GLCounters.indirectCommands += drawcount;
+	glad_counted_glMultiDrawArraysIndirect(mode, indirect, drawcount, stride);
+}
+static PFNGLMULTIDRAWELEMENTSINDIRECTPROC glad_counted_glMultiDrawElementsIndirect = NULL;
+static void APIENTRY glad_count_glMultiDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride) {
+	GLCounters.indirectDraws++;
+	GLCounters.indirectCommands += drawcount;
+	glad_counted_glMultiDrawElementsIndirect(mode, type, indirect, drawcount, stride);
+}
+static PFNGLBUFFERDATAPROC glad_counted_glBufferData = NULL;
+static void APIENTRY glad_count_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+	/* bez dat jde jen o alokaci */
+	if (data != NULL) {
+		GLCounters.uploadCalls++;
+		GLCounters.uploadBytes += size;
+	}
+	glad_counted_glBufferData(target, size, data, usage);
+}
+static PFNGLBUFFERSUBDATAPROC glad_counted_glBufferSubData = NULL;
+static void APIENTRY glad_count_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+	GLCounters.uploadCalls++;
+	GLCounters.uploadBytes += size;
+	glad_counted_glBufferSubData(target, offset, size, data);
+}
+static PFNGLUSEPROGRAMPROC glad_counted_glUseProgram = NULL;
+static void APIENTRY glad_count_glUseProgram(GLuint program) {
+	GLCounters.programSwitches++;
+	glad_counted_glUseProgram(program);
+}
+static PFNGLBINDVERTEXARRAYPROC glad_counted_glBindVertexArray = NULL;
+static void APIENTRY glad_count_glBindVertexArray(GLuint array) {
+	GLCounters.vertexArrayBinds++;
+	glad_counted_glBindVertexArray(array);
+}
+static PFNGLBINDBUFFERPROC glad_counted_glBindBuffer = NULL;
+static void APIENTRY glad_count_glBindBuffer(GLenum target, GLuint buffer) {
+	GLCounters.bufferBinds++;
+	glad_counted_glBindBuffer(target, buffer);
+}
+static PFNGLBINDBUFFERBASEPROC glad_counted_glBindBufferBase = NULL;
+static void APIENTRY glad_count_glBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+	GLCounters.bufferBinds++;
+	glad_counted_glBindBufferBase(target, index, buffer);
+}
+static PFNGLUNIFORM1IPROC glad_counted_glUniform1i = NULL;
+static void APIENTRY glad_count_glUniform1i(GLint location, GLint v0) {
+	GLCounters.uniformUpdates++;
+	glad_counted_glUniform1i(location, v0);
+}
+static PFNGLUNIFORM1FPROC glad_counted_glUniform1f = NULL;
+static void APIENTRY glad_count_glUniform1f(GLint location, GLfloat v0) {
+	GLCounters.uniformUpdates++;
+	glad_counted_glUniform1f(location, v0);
+}
+static PFNGLUNIFORM2FPROC glad_counted_glUniform2f = NULL;
+static void APIENTRY glad_count_glUniform2f(GLint location, GLfloat v0, GLfloat v1) {
+	GLCounters.uniformUpdates++;
+	glad_counted_glUniform2f(location, v0, v1);
+}
+static PFNGLUNIFORM3FPROC glad_counted_glUniform3f = NULL;
+static void APIENTRY glad_count_glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+	GLCounters.uniformUpdates++;
+	glad_counted_glUniform3f(location, v0, v1, v2);
+}
+static PFNGLUNIFORM4FPROC glad_counted_glUniform4f = NULL;
+static void APIENTRY glad_count_glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+	GLCounters.uniformUpdates++;
+	glad_counted_glUniform4f(location, v0, v1, v2, v3);
+}
+static PFNGLUNIFORMMATRIX4FVPROC glad_counted_glUniformMatrix4fv = NULL;
+static void APIENTRY glad_count_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	GLCounters.uniformUpdates++;
+	glad_counted_glUniformMatrix4fv(location, count, transpose, value);
+}
+
+static void install_GL_counters(void) {
+	if (glad_glDrawArrays != NULL) { glad_counted_glDrawArrays = glad_glDrawArrays; glad_glDrawArrays = glad_count_glDrawArrays; }
+	if (glad_glDrawElements != NULL) { glad_counted_glDrawElements = glad_glDrawElements; glad_glDrawElements = glad_count_glDrawElements; }
+	if (glad_glDrawArraysInstanced != NULL) { glad_counted_glDrawArraysInstanced = glad_glDrawArraysInstanced; glad_glDrawArraysInstanced = glad_count_glDrawArraysInstanced; }
+	if (glad_glDrawElementsInstanced != NULL) { glad_counted_glDrawElementsInstanced = glad_glDrawElementsInstanced; glad_glDrawElementsInstanced = glad_count_glDrawElementsInstanced; }
+	if (glad_glDrawArraysIndirect != NULL) { glad_counted_glDrawArraysIndirect = glad_glDrawArraysIndirect; glad_glDrawArraysIndirect = glad_count_glDrawArraysIndirect; }
+	if (glad_glDrawElementsIndirect != NULL) { glad_counted_glDrawElementsIndirect = glad_glDrawElementsIndirect; glad_glDrawElementsIndirect = glad_count_glDrawElementsIndirect; }
+	if (glad_glMultiDrawArraysIndirect != NULL) { glad_counted_glMultiDrawArraysIndirect = glad_glMultiDrawArraysIndirect; glad_glMultiDrawArraysIndirect = glad_count_glMultiDrawArraysIndirect; }
+	if (glad_glMultiDrawElementsIndirect != NULL) { glad_counted_glMultiDrawElementsIndirect = glad_glMultiDrawElementsIndirect; glad_glMultiDrawElementsIndirect = glad_count_glMultiDrawElementsIndirect; }
+	if (glad_glBufferData != NULL) { glad_counted_glBufferData = glad_glBufferData; glad_glBufferData = glad_count_glBufferData; }
+	if (glad_glBufferSubData != NULL) { glad_counted_glBufferSubData = glad_glBufferSubData; glad_glBufferSubData = glad_count_glBufferSubData; }
+	if (glad_glUseProgram != NULL) { glad_counted_glUseProgram = glad_glUseProgram; glad_glUseProgram = glad_count_glUseProgram; }
+	if (glad_glBindVertexArray != NULL) { glad_counted_glBindVertexArray = glad_glBindVertexArray; glad_glBindVertexArray = glad_count_glBindVertexArray; }
+	if (glad_glBindBuffer != NULL) { glad_counted_glBindBuffer = glad_glBindBuffer; glad_glBindBuffer = glad_count_glBindBuffer; }
+	if (glad_glBindBufferBase != NULL) { glad_counted_glBindBufferBase = glad_glBindBufferBase; glad_glBindBufferBase = glad_count_glBindBufferBase; }
+	if (glad_glUniform1i != NULL) { glad_counted_glUniform1i = glad_glUniform1i; glad_glUniform1i = glad_count_glUniform1i; }
+	if (glad_glUniform1f != NULL) { glad_counted_glUniform1f = glad_glUniform1f; glad_glUniform1f = glad_count_glUniform1f; }
+	if (glad_glUniform2f != NULL) { glad_counted_glUniform2f = glad_glUniform2f; glad_glUniform2f = glad_count_glUniform2f; }
+	if (glad_glUniform3f != NULL) { glad_counted_glUniform3f = glad_glUniform3f; glad_glUniform3f = glad_count_glUniform3f; }
+	if (glad_glUniform4f != NULL) { glad_counted_glUniform4f = glad_glUniform4f; glad_glUniform4f = glad_count_glUniform4f; }
+	if (glad_glUniformMatrix4fv != NULL) { glad_counted_glUniformMatrix4fv = glad_glUniformMatrix4fv; glad_glUniformMatrix4fv = glad_count_glUniformMatrix4fv; }
+}
+#endif
+
+
 int gladLoadGLLoader(GLADloadproc load) {
 	GLVersion.major = 0; GLVersion.minor = 0;
 	glGetString = (PFNGLGETSTRINGPROC)load("glGetString");
@@ -1135,6 +1345,16 @@ int gladLoadGLLoader(GLADloadproc load) {
 	load_GL_VERSION_3_3(load);
 
 	if (!find_extensionsGL()) return 0;
+	load_GL_ARB_buffer_storage(load);
+	load_GL_ARB_compute_shader(load);
+	load_GL_ARB_draw_indirect(load);
+	load_GL_ARB_multi_draw_indirect(load);
+	load_GL_ARB_shader_image_load_store(load);
+	load_GL_ARB_shader_storage_buffer_object(load);
+	load_GL_ARB_tessellation_shader(load);
+#ifdef GLAD_GL_COUNTERS
+	install_GL_counters();
+#endif
 	return GLVersion.major != 0 || GLVersion.minor != 0;
 }
 
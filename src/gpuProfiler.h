@@ -0,0 +1,149 @@
+#pragma once
+#include "glad.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cstdio>
+
+/*
+ mereni casu jednotlivych prubehu (passu) na GPU pomoci casovych razitek (glQueryCounter + GL_TIMESTAMP)
+ - kazdy prubeh ma dvojici dotazu (zacatek, konec) pro kazdou ze dvou sad; sada se precte az na zacatku
+   snimku, ktery ji znovu pouzije (o dva snimky pozdeji), takze cteni necheka na GPU
+ - pokud vysledek jeste neni k dispozici, zopakuje se posledni hodnota (misto cekani)
+ - razitka se na rozdil od GL_TIME_ELAPSED mohou prekryvat, prubeh Frame obsahuje vsechny ostatni
+*/
+
+enum class GpuPass
+{
+    Frame = 0,
+    Curve,
+    ControlPoints,
+    SurfaceMarkers,
+    SurfaceMesh,
+    Compute,
+    ImGui,
+    Count
+};
+
+const int GpuPassCount = static_cast<int>(GpuPass::Count);
+const int GpuProfilerBuffers = 2;
+const int GpuProfilerHistory = 120;
+
+struct GpuProfiler
+{
+    bool enabled = false;
+    unsigned int queries[GpuProfilerBuffers][GpuPassCount][2] = {};
+    bool issued[GpuProfilerBuffers][GpuPassCount] = {};
+    int buffer = 0;
+    // casy v ms, kruhova historie pro graf
+    float history[GpuPassCount][GpuProfilerHistory] = {};
+    int historyOffset = 0;
+};
+
+const char* gpuPassName(GpuPass pass)
+{
+    static const char* names[GpuPassCount] = { "Frame", "Curve", "Control points", "Surface markers",
+                                               "Surface mesh", "Compute", "ImGui" };
+    return names[static_cast<int>(pass)];
+}
+
+// jediny profiler, aby ho mohly pouzivat vykreslovaci funkce bez dalsiho parametru
+GpuProfiler& gpuProfiler()
+{
+    static GpuProfiler profiler;
+    return profiler;
+}
+
+void setGpuProfilerEnabled(bool enabled)
+{
+    GpuProfiler& profiler = gpuProfiler();
+    if (enabled && !profiler.queries[0][0][0]) {
+        glGenQueries(GpuProfilerBuffers * GpuPassCount * 2, &profiler.queries[0][0][0]);
+    }
+    std::fill(&profiler.issued[0][0], &profiler.issued[0][0] + GpuProfilerBuffers * GpuPassCount, false);
+    profiler.enabled = enabled;
+}
+
+void beginGpuPass(GpuPass pass)
+{
+    GpuProfiler& profiler = gpuProfiler();
+    if (profiler.enabled) {
+        glQueryCounter(profiler.queries[profiler.buffer][static_cast<int>(pass)][0], GL_TIMESTAMP);
+    }
+}
+
+void endGpuPass(GpuPass pass)
+{
+    GpuProfiler& profiler = gpuProfiler();
+    if (profiler.enabled) {
+        glQueryCounter(profiler.queries[profiler.buffer][static_cast<int>(pass)][1], GL_TIMESTAMP);
+        profiler.issued[profiler.buffer][static_cast<int>(pass)] = true;
+    }
+}
+
+// na zacatku snimku: precte vysledky starsi sady do historie a tuto sadu pouzije pro novy snimek
+void beginGpuProfilerFrame()
+{
+    GpuProfiler& profiler = gpuProfiler();
+    if (!profiler.enabled) {
+        return;
+    }
+    int oldest = (profiler.buffer + GpuProfilerBuffers - 1) % GpuProfilerBuffers;
+    profiler.historyOffset = (profiler.historyOffset + 1) % GpuProfilerHistory;
+    for (int pass = 0; pass < GpuPassCount; ++pass) {
+        float ms = 0.0f;
+        if (profiler.issued[oldest][pass]) {
+            GLint available = 0;
+            glGetQueryObjectiv(profiler.queries[oldest][pass][1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint64 begin = 0;
+                GLuint64 end = 0;
+                glGetQueryObjectui64v(profiler.queries[oldest][pass][0], GL_QUERY_RESULT, &begin);
+                glGetQueryObjectui64v(profiler.queries[oldest][pass][1], GL_QUERY_RESULT, &end);
+                ms = static_cast<float>(end - begin) / 1.0e6f;
+            } else {
+                // vysledek jeste neni, zopakuje se posledni hodnota
+                int last = (profiler.historyOffset + GpuProfilerHistory - 1) % GpuProfilerHistory;
+                ms = profiler.history[pass][last];
+            }
+        }
+        profiler.history[pass][profiler.historyOffset] = ms;
+        profiler.issued[oldest][pass] = false;
+    }
+    profiler.buffer = oldest;
+}
+
+// posledni zmereny cas prubehu v ms
+float gpuPassMs(GpuPass pass)
+{
+    const GpuProfiler& profiler = gpuProfiler();
+    return profiler.history[static_cast<int>(pass)][profiler.historyOffset];
+}
+
+// graf historie kazdeho prubehu v okne Settings
+void drawGpuProfiler()
+{
+    bool enabled = gpuProfiler().enabled;
+    if (ImGui::Checkbox("Measure GPU passes", &enabled)) {
+        setGpuProfilerEnabled(enabled);
+    }
+    if (!enabled) {
+        return;
+    }
+    GpuProfiler& profiler = gpuProfiler();
+    for (int pass = 0; pass < GpuPassCount; ++pass) {
+        const float* values = profiler.history[pass];
+        float average = 0.0f;
+        float maximum = 0.0f;
+        for (int i = 0; i < GpuProfilerHistory; ++i) {
+            average += values[i];
+            maximum = std::max(maximum, values[i]);
+        }
+        average /= GpuProfilerHistory;
+        char overlay[48];
+        std::snprintf(overlay, sizeof(overlay), "%.3f ms (avg %.3f)", gpuPassMs(static_cast<GpuPass>(pass)), average);
+        // historyOffset je nejnovejsi hodnota, graf zacina nejstarsi
+        ImGui::PlotLines(gpuPassName(static_cast<GpuPass>(pass)), values, GpuProfilerHistory,
+                         (profiler.historyOffset + 1) % GpuProfilerHistory, overlay, 0.0f, std::max(maximum, 0.1f),
+                         ImVec2(0, 40));
+    }
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include "glad.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ headless rezim (--headless) pro servery bez displeje
+ - okno GLFW je neviditelne, kresli se do vlastniho framebufferu (FBO) a ImGui se nevykresluje,
+   takze ulozene snimky obsahuji jen scenu a daji se porovnavat mezi behy
+ - bez scenare se vykresli --frames snimku a posledni se ulozi jako PPM
+ - scenar je textovy soubor s jednim prikazem na radek (# uvozuje komentar):
+     frames N               vykresli N snimku
+     dump [soubor]          ulozi posledni vykresleny snimek (bez jmena <output>_NNNN.ppm)
+     mode 2d|3d             prepne zobrazeni
+     step S                 krok krivky (2d) nebo plochy (3d)
+     evaluator N            vyhodnocovani krivky (poradi jako v menu)
+     backend N              vyhodnocovani plochy (poradi jako v menu)
+     point I X Y            kontrolni bod krivky (2d)
+     point R C X Y Z        kontrolni bod plochy (3d)
+     camera X Y Z           pozice kamery
+*/
+
+struct HeadlessOptions
+{
+    bool enabled = false;
+    int frames = 1;
+    std::string scenarioPath;
+    std::string outputPrefix = "frame";
+    int width = 1000;
+    int height = 600;
+    // nahravani snimku od spusteni (i mimo headless rezim), viz frameCapture.h
+    std::string recordPath;
+    // zaznam CPU zon od spusteni a zapis pri ukonceni, viz cpuProfiler.h
+    std::string tracePath;
+    // CSV s casy snimku pri ukonceni, viz frameStats.h
+    std::string statsPath;
+    // kreslit kazdy snimek i bez zmen (mereni vykonu), viz redrawScheduler.h
+    bool continuous = false;
+};
+
+void printHeadlessUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--headless] [--frames N] [--scenario FILE] [--output PREFIX] [--size WxH] [--record FILE.y4m|PREFIX] [--trace FILE.json] [--stats FILE.csv] [--continuous]\n";
+}
+
+// vrati false pri neplatnych argumentech
+bool parseHeadlessOptions(int argc, char** argv, HeadlessOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--headless") {
+            options.enabled = true;
+        } else if (arg == "--continuous") {
+            options.continuous = true;
+        } else if (arg == "--frames" && hasValue) {
+            options.frames = std::atoi(argv[++i]);
+        } else if (arg == "--scenario" && hasValue) {
+            options.scenarioPath = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            options.outputPrefix = argv[++i];
+        } else if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            options.tracePath = argv[++i];
+        } else if (arg == "--stats" && hasValue) {
+            options.statsPath = argv[++i];
+        } else if (arg == "--size" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return options.frames > 0 && options.width > 0 && options.height > 0;
+}
+
+// framebuffer, do ktereho se v headless rezimu kresli misto okna
+struct HeadlessTarget
+{
+    unsigned int FBO = 0;
+    unsigned int colorBuffer = 0;
+    unsigned int depthBuffer = 0;
+    int width = 0;
+    int height = 0;
+};
+
+HeadlessTarget createHeadlessTarget(int width, int height)
+{
+    HeadlessTarget target;
+    target.width = width;
+    target.height = height;
+    glGenFramebuffers(1, &target.FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.FBO);
+
+    glGenRenderbuffers(1, &target.colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target.colorBuffer);
+
+    glGenRenderbuffers(1, &target.depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.depthBuffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Headless framebuffer is incomplete\n";
+    }
+    return target;
+}
+
+void destroyHeadlessTarget(HeadlessTarget& target)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteRenderbuffers(1, &target.colorBuffer);
+    glDeleteRenderbuffers(1, &target.depthBuffer);
+    glDeleteFramebuffers(1, &target.FBO);
+    target = HeadlessTarget();
+}
+
+// zapise RGB pixely (radky zdola nahoru jako z glReadPixels) do binarniho PPM
+bool writeFramePpm(const std::string& path, int width, int height, const unsigned char* pixels)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Unable to write frame: " << path << "\n";
+        return false;
+    }
+    file << "P6\n" << width << " " << height << "\n255\n";
+    for (int y = height - 1; y >= 0; --y) {
+        file.write(reinterpret_cast<const char*>(pixels + static_cast<size_t>(y) * width * 3), width * 3);
+    }
+    return true;
+}
+
+// precte obsah framebufferu a ulozi ho (synchronni cteni, vola se jen pri prikazu dump)
+bool dumpHeadlessFrame(const HeadlessTarget& target, const std::string& path)
+{
+    std::vector<unsigned char> pixels(static_cast<size_t>(target.width) * target.height * 3);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, target.FBO);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, target.width, target.height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+    return writeFramePpm(path, target.width, target.height, pixels.data());
+}
+
+struct HeadlessScenario
+{
+    std::vector<std::vector<std::string>> commands;
+    size_t next = 0;
+    // kolik snimku se jeste ma vykreslit pred dalsim prikazem
+    int framesLeft = 0;
+    int framesRendered = 0;
+    int dumpCount = 0;
+};
+
+// bez scenare: N snimku a ulozeni posledniho
+HeadlessScenario makeHeadlessScenario(int frames)
+{
+    HeadlessScenario scenario;
+    scenario.commands.push_back({ "frames", std::to_string(frames) });
+    scenario.commands.push_back({ "dump" });
+    return scenario;
+}
+
+bool loadHeadlessScenario(const std::string& path, HeadlessScenario& scenario)
+{
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Unable to open scenario: " << path << "\n";
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream tokens(line);
+        std::vector<std::string> command;
+        std::string token;
+        while (tokens >> token) {
+            command.push_back(token);
+        }
+        if (!command.empty()) {
+            scenario.commands.push_back(command);
+        }
+    }
+    return true;
+}
+
+// vrati dalsi prikaz pro nastaveni sceny; false, pokud se ma vykreslit snimek nebo scenar skoncil
+// prikaz frames zpracuje sam
+bool nextHeadlessCommand(HeadlessScenario& scenario, std::vector<std::string>& command)
+{
+    while (scenario.framesLeft == 0 && scenario.next < scenario.commands.size()) {
+        const std::vector<std::string>& current = scenario.commands[scenario.next++];
+        if (current[0] == "frames" && current.size() == 2) {
+            scenario.framesLeft = std::max(0, std::atoi(current[1].c_str()));
+            continue;
+        }
+        command = current;
+        return true;
+    }
+    return false;
+}
+
+bool headlessScenarioFinished(const HeadlessScenario& scenario)
+{
+    return scenario.framesLeft == 0 && scenario.next >= scenario.commands.size();
+}
+
+void headlessFrameRendered(HeadlessScenario& scenario)
+{
+    scenario.framesLeft--;
+    scenario.framesRendered++;
+}
+
+// jmeno souboru pro dump bez explicitniho jmena
+std::string headlessDumpPath(HeadlessScenario& scenario, const std::string& outputPrefix)
+{
+    char index[16];
+    std::snprintf(index, sizeof(index), "_%04d", scenario.dumpCount++);
+    return outputPrefix + index + ".ppm";
+}
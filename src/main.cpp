@@ -14,7 +14,16 @@
 #include "camera.h"
 #include "bezierCurve.h"
 #include "bezierSurface.h"
+#include "bezierTemplate.h"
 #include "cube.h"
+#include "shaderProgram.h"
+#include "headless.h"
+#include "frameCapture.h"
+#include "gpuProfiler.h"
+#include "cpuProfiler.h"
+#include "frameStats.h"
+#include "glCounters.h"
+#include "redrawScheduler.h"
 
 /*
   POPIS PROGRAMU
@@ -28,6 +37,9 @@
 - v menu dale je zde take umozneno menit krok plochy (tj. její spojitost)
 - otaceni kamery v 3d je umozneno pomoci tlacitek WASD (pro rotaci), mezernik pro oddaleni kamery 
   a shift pro priblizeni
+- s prepinacem --headless program kresli bez okna do FBO a uklada snimky (viz headless.h)
+- F12 zapne mereni CPU zon, dalsi stisk je zapise do trace.json (viz cpuProfiler.h)
+- okno se prekresluje jen po vstupu nebo zmene (viz redrawScheduler.h), --continuous kresli porad
 */
 
 // k uzavreni okna
@@ -58,44 +70,56 @@ const char* readShader(const std::string& filename)
 }
 
 // 3d a 2d
-std::vector<unsigned int> handleShaderProgram(const char* fragment_shaderCode, const char* vertex_shaderCode)
+// modelova matice je ve vsech cestach identita, hodnota uniformy v programu zustava, staci ji nastavit jednou
+void setIdentityModelMatrix(const ShaderProgram& program)
 {
-    // vertex shader
-    unsigned int vertexShader;
-    vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertex_shaderCode, NULL);
-    glCompileShader(vertexShader);
-
-    // fragment shader
-    unsigned int fragmentShader;
-    fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragment_shaderCode, NULL);
-    glCompileShader(fragmentShader);
-
-    // shader program
-    unsigned int shaderProgram;
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    glUseProgram(shaderProgram);
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    return {shaderProgram}; 
+    program.Use();
+    program.SetMat4(program.UniformLocation("modelMatrix"), glm::mat4(1.0f));
 }
 
-int main() 
+ShaderProgram handleShaderProgram(const char* fragment_shaderCode, const char* vertex_shaderCode)
 {
+    ShaderProgram program({ { GL_VERTEX_SHADER, vertex_shaderCode }, { GL_FRAGMENT_SHADER, fragment_shaderCode } });
+    setIdentityModelMatrix(program);
+    return program;
+}
+
+// program s teselacnimi shadery (vertex, tess control, tess evaluation, fragment)
+ShaderProgram handleTessellationShaderProgram(const char* fragment_shaderCode, const char* vertex_shaderCode,
+                                              const char* control_shaderCode, const char* evaluation_shaderCode)
+{
+    ShaderProgram program({ { GL_VERTEX_SHADER, vertex_shaderCode }, { GL_TESS_CONTROL_SHADER, control_shaderCode },
+                            { GL_TESS_EVALUATION_SHADER, evaluation_shaderCode }, { GL_FRAGMENT_SHADER, fragment_shaderCode } });
+    setIdentityModelMatrix(program);
+    return program;
+}
+
+// program s jedinym compute shaderem
+ShaderProgram handleComputeShaderProgram(const char* compute_shaderCode)
+{
+    return ShaderProgram({ { GL_COMPUTE_SHADER, compute_shaderCode } });
+}
+
+int main(int argc, char** argv) 
+{
+    HeadlessOptions headless;
+    if (!parseHeadlessOptions(argc, argv, headless)) {
+        printHeadlessUsage(argv[0]);
+        return -1;
+    }
+
     if(!glfwInit()){
         std::cerr << "Failed to initialize GLFW\n";
         return -1;
     }
 
-    // velikosti okna
-    const unsigned int width = 1000;
-    const unsigned int height = 600;
+    // velikosti okna (v headless rezimu velikost ukladanych snimku)
+    const unsigned int width = headless.enabled ? headless.width : 1000;
+    const unsigned int height = headless.enabled ? headless.height : 600;
 
+    if (headless.enabled) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
     GLFWwindow* window = glfwCreateWindow(width, height, "Bezier Curves", NULL, NULL);
     if (window == NULL) {
         std::cerr << "Failed to create GLFW window\n";
@@ -103,7 +127,9 @@ int main()
         return -1;
     }
     glfwMakeContextCurrent(window);
-    glfwSetWindowSizeLimits(window, 850, 600, GLFW_DONT_CARE, GLFW_DONT_CARE);
+    if (!headless.enabled) {
+        glfwSetWindowSizeLimits(window, 850, 600, GLFW_DONT_CARE, GLFW_DONT_CARE);
+    }
 
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cerr << "Failed to initialize GLAD\n";
@@ -113,19 +139,45 @@ int main()
     // barva pozadi okna
     glClearColor(0, 0, 0, 1.0f);
 
+    // v headless rezimu se kresli do FBO podle scenare (nebo --frames snimku)
+    HeadlessTarget headlessTarget;
+    HeadlessScenario scenario = makeHeadlessScenario(headless.frames);
+    if (headless.enabled) {
+        if (!headless.scenarioPath.empty()) {
+            scenario = HeadlessScenario();
+            if (!loadHeadlessScenario(headless.scenarioPath, scenario)) {
+                glfwTerminate();
+                return -1;
+            }
+        }
+        headlessTarget = createHeadlessTarget(width, height);
+    }
+
 
     //IMGUI
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    if (headless.enabled) {
+        // na serveru se nastaveni oken neuklada
+        io.IniFilename = nullptr;
+    }
     ImGui::StyleColorsDark();
+    // udalosti oznacuji snimky k prekresleni (vykreslovani na vyzadani)
+    installRedrawCallbacks(window);
+    redrawScheduler().onDemand = !headless.enabled && !headless.continuous;
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init("#version 330");
     // 2d/3d zobrazení
     bool is2DMode = true;
     // krok bezierovy krivky 2d
     float step2d = 0.01f;
+    // vyhodnocovani krivky (0 = bernstein, 1 = dopredne diference, 2 = SIMD, 3 = adaptivni) a interval prepocitani diferenci
+    int curveEvaluator = 0;
+    int reanchorInterval = 256;
+    // tolerance adaptivniho deleni krivky v pixelech
+    float tolerancePx = 0.25f;
 
     // kontrolni body pro 2d
     glm::vec3 controlPoints2d[4] = {
@@ -138,46 +190,188 @@ int main()
     // kontrolní body pro 3d
     glm::vec3 controlPoints3d[4][4];
     generatePointsOnGrid(0.5f, 0.5f, controlPoints3d);
-    std::vector<glm::vec3> bezierSurfacePoints;
     // krok bezierovy krivky 3d
     float step3d = 0.05f;
 
-    // inicializace shaderu
+    // inicializace shaderu, spolecny kod (baze, osvetleni) se vklada do vsech
+    shaderCommonSource() = readShader("../shaders/bezier_common.glsl");
     std::string shaderPath = "../shaders/fragment_shader.glsl";
     const char* fragment_shaderCode = readShader(shaderPath);
     shaderPath = "../shaders/vertex_shader.glsl";
     const char* vertex_shaderCode = readShader(shaderPath);
+    shaderPath = "../shaders/surface_vertex_shader.glsl";
+    const char* surface_vertex_shaderCode = readShader(shaderPath);
+    shaderPath = "../shaders/bezier_surface_vertex_shader.glsl";
+    const char* bezier_surface_vertex_shaderCode = readShader(shaderPath);
+    shaderPath = "../shaders/tess_vertex_shader.glsl";
+    const char* tess_vertex_shaderCode = readShader(shaderPath);
+    shaderPath = "../shaders/tess_control_shader.glsl";
+    const char* tess_control_shaderCode = readShader(shaderPath);
+    shaderPath = "../shaders/tess_evaluation_shader.glsl";
+    const char* tess_evaluation_shaderCode = readShader(shaderPath);
+    shaderPath = "../shaders/bezier_surface_compute_shader.glsl";
+    const char* bezier_surface_compute_shaderCode = readShader(shaderPath);
 
     // 2d shader
-    std::vector<unsigned int> setUpShader = handleShaderProgram(fragment_shaderCode,vertex_shaderCode);
-    std::vector<unsigned int> setup2d = handlePointsIntoBuffers(controlPoints2d);
-    setup2d.insert(setup2d.begin(), setUpShader.begin(), setUpShader.end());
+    ShaderProgram setUpShader = handleShaderProgram(fragment_shaderCode,vertex_shaderCode);
+    // body krivky se zapisuji primo do namapovaneho kruhoveho bufferu (pri vetsim poctu bodu se zvetsi)
+    StreamBuffer curveStream;
+    createStreamBuffer(curveStream, sizeof(glm::vec3), 4096);
+    std::vector<unsigned int> setup2d = handlePointsIntoBuffers(controlPoints2d, curveStream);
 
     // 3d nacteni kostek
     std::vector<float> cubeVertices = generateCubeVertices(0.1f);
     std::vector<unsigned int> cubeIndices = generateCubeIndices();
     std::vector<unsigned int> cubeBuffers = handleCubeIntoBuffers(cubeVertices, cubeIndices);
 
+    // 3d sit plochy s vlastnim shaderem (osvetleni podle normal)
+    ShaderProgram surfaceShader = handleShaderProgram(fragment_shaderCode, surface_vertex_shaderCode);
+    SurfaceMesh surfaceMesh = handleSurfaceMeshIntoBuffers();
+    bool showSurfaceMesh = true;
+    bool showSampleMarkers = true;
+
+    // plocha vyhodnocovana ve vertex shaderu z mrizky parametru
+    ShaderProgram gpuSurfaceShader = handleShaderProgram(fragment_shaderCode, bezier_surface_vertex_shaderCode);
+    SurfaceGpuGrid surfaceGpuGrid = handleSurfaceGpuGridIntoBuffers(gpuSurfaceShader);
+    // hardwarova teselace jen pokud ji ovladac podporuje, jinak zustava vypocet na CPU
+    bool tessellationSupported = GLAD_GL_ARB_tessellation_shader != 0;
+    ShaderProgram tessSurfaceShader;
+    SurfaceTessellationPatch surfaceTessellationPatch;
+    if (tessellationSupported) {
+        tessSurfaceShader = handleTessellationShaderProgram(fragment_shaderCode, tess_vertex_shaderCode,
+                                                            tess_control_shaderCode, tess_evaluation_shaderCode);
+        surfaceTessellationPatch = handleSurfaceTessellationIntoBuffers(tessSurfaceShader);
+    }
+    // compute shadery a kresleni s argumenty v bufferu (GL 4.3)
+    bool computeSupported = (GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 3)) &&
+                            GLAD_GL_ARB_compute_shader && GLAD_GL_ARB_shader_storage_buffer_object &&
+                            GLAD_GL_ARB_multi_draw_indirect && GLAD_GL_ARB_shader_image_load_store;
+    ShaderProgram computeSurfaceShader;
+    SurfaceComputeBatch surfaceComputeBatch;
+    if (computeSupported) {
+        computeSurfaceShader = handleComputeShaderProgram(bezier_surface_compute_shaderCode);
+        surfaceComputeBatch = handleSurfaceComputeIntoBuffers(computeSurfaceShader);
+    }
+    // 0 = CPU, 1 = vertex shader, 2 = teselace, 3 = compute shader, 4 = CPU (GEMM)
+    int surfaceBackend = 0;
+    float tessPixelsPerSegment = 8.0f;
+
     // umoznuje nepruhlednost v 3d zobrazeni
     glEnable(GL_DEPTH_TEST);
 
     Camera camera(width,height, glm::vec3(40.0f,40.0f,30.0f));
 
+    // krivka a plocha se prepocitavaji jen pri zmene kontrolnich bodu, kroku nebo nastaveni
+    CurveCache curveCache;
+    SurfaceCache surfaceCache;
+
     // pro manipulaci bodu v 3d
     int selectedRow = 0;
     int selectedCol = 0;
     float moveSpeed = 0.01f;
 
+    const bool surfaceBackendSupported[] = { true, true, tessellationSupported, computeSupported, true };
+    auto selectSurfaceBackend = [&](int backend) {
+        if (backend < 0 || backend > 4 || !surfaceBackendSupported[backend] || backend == surfaceBackend) {
+            return;
+        }
+        surfaceBackend = backend;
+        // vsechny cesty sdileji buffer instanci, po prepnuti se nahraje znovu
+        // (obe CPU cesty sdileji cache, spocita se znovu vybranym zpusobem)
+        surfaceCache.valid = false;
+        surfaceCache.gpuDirty = true;
+        surfaceGpuGrid.controlPointsValid = false;
+        surfaceTessellationPatch.controlPointsValid = false;
+        surfaceComputeBatch.controlPointsValid = false;
+    };
+
+    // provede prikaz headless scenare, ktery meni scenu (frames zpracuje scenar sam)
+    auto applyScenarioCommand = [&](const std::vector<std::string>& command) {
+        auto arg = [&](size_t i) { return static_cast<float>(std::atof(command[i].c_str())); };
+        const std::string& name = command[0];
+        if (name == "dump") {
+            dumpHeadlessFrame(headlessTarget, command.size() > 1 ? command[1] : headlessDumpPath(scenario, headless.outputPrefix));
+        } else if (name == "mode" && command.size() == 2) {
+            is2DMode = command[1] == "2d";
+        } else if (name == "step" && command.size() == 2) {
+            (is2DMode ? step2d : step3d) = arg(1);
+        } else if (name == "evaluator" && command.size() == 2) {
+            curveEvaluator = std::clamp(static_cast<int>(arg(1)), 0, 3);
+        } else if (name == "backend" && command.size() == 2) {
+            selectSurfaceBackend(static_cast<int>(arg(1)));
+        } else if (name == "point" && command.size() == 4) {
+            controlPoints2d[static_cast<int>(arg(1)) & 3] = glm::vec3(arg(2), arg(3), 0.0f);
+        } else if (name == "point" && command.size() == 6) {
+            controlPoints3d[static_cast<int>(arg(1)) & 3][static_cast<int>(arg(2)) & 3] = glm::vec3(arg(3), arg(4), arg(5));
+        } else if (name == "camera" && command.size() == 4) {
+            camera.Position = glm::vec3(arg(1), arg(2), arg(3));
+        } else {
+            std::cerr << "Unknown scenario command: " << name << "\n";
+        }
+    };
+    if (headless.enabled) {
+        glBindFramebuffer(GL_FRAMEBUFFER, headlessTarget.FBO);
+    }
+    double headlessStart = glfwGetTime();
+
+    // nahravani snimku (prepinac --record nebo menu)
+    FrameCapture frameCapture;
+    std::string recordPath = headless.recordPath.empty() ? "capture.y4m" : headless.recordPath;
+    if (!headless.recordPath.empty()) {
+        startFrameCapture(frameCapture, recordPath, width, height);
+    }
+
+    // CPU zony (prepinac --trace, menu nebo F12 pro zapis)
+    std::string tracePath = headless.tracePath.empty() ? "trace.json" : headless.tracePath;
+    setCpuProfilerThreadName("Main");
+    setCpuProfilerEnabled(!headless.tracePath.empty());
+    bool traceKeyDown = false;
+
+    // percentily casu snimku (panel v menu, --stats zapise CSV pri ukonceni)
+    FrameStats frameStats;
+    std::string statsPath = headless.statsPath.empty() ? "frame_stats.csv" : headless.statsPath;
+
     while (!glfwWindowShouldClose(window))
     {
+        // kdyz se nic nedeje, smycka spi a nekresli (nahravani potrebuje vsechny snimky)
+        if (!redrawNeeded(frameCapture.active)) {
+            pauseFrameStats(frameStats);
+            waitForRedraw();
+            continue;
+        }
+        CPU_ZONE("Frame");
+        if (headless.enabled) {
+            std::vector<std::string> command;
+            while (nextHeadlessCommand(scenario, command)) {
+                applyScenarioCommand(command);
+            }
+            if (headlessScenarioFinished(scenario)) {
+                break;
+            }
+        }
+        // vysledky mereni GPU z predchozich snimku
+        beginGpuProfilerFrame();
+        beginFrameStats(frameStats, gpuProfiler().enabled ? gpuPassMs(GpuPass::Frame) : -1.0f);
+        beginGlCountersFrame();
         glfwPollEvents();
         processInput(window);
+        // F12 zapise dosud zaznamenane zony (pri prvnim stisku zaznam zapne)
+        bool traceKeyPressed = glfwGetKey(window, GLFW_KEY_F12) == GLFW_PRESS;
+        if (traceKeyPressed && !traceKeyDown) {
+            if (cpuProfilerEnabled()) {
+                writeCpuTrace(tracePath);
+            } else {
+                setCpuProfilerEnabled(true);
+            }
+        }
+        traceKeyDown = traceKeyPressed;
 
         // IMGUI nacteni
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
         {
+            CPU_ZONE("Build UI");
             static int counter = 0;
             ImGui::Begin("Settings");
             
@@ -189,11 +383,43 @@ int main()
                 if (ImGui::Button("Go 3D plane")) {
                     is2DMode = false;
                 }
+                if (!headless.enabled) {
+                    ImGui::Checkbox("Render only on changes", &redrawScheduler().onDemand);
+                }
+                bool recording = frameCapture.active;
+                if (ImGui::Checkbox(("Record to " + recordPath).c_str(), &recording)) {
+                    if (recording) {
+                        startFrameCapture(frameCapture, recordPath, width, height);
+                    } else {
+                        stopFrameCapture(frameCapture);
+                    }
+                }
+                if (frameCapture.active) {
+                    ImGui::Text("Captured %d frames, readback %.3f ms/frame", frameCapture.framesRead, frameCapture.lastCaptureMs);
+                }
             }
 
             // umoznuje ovladani jednotlivych bodu krivky v 2d
             if (is2DMode && ImGui::CollapsingHeader("2d bezier curves")) {
-                ImGui::SliderFloat("Step", &step2d, 0.01f, 1.0f, "%.3f");
+                ImGui::SliderFloat("Step", &step2d, 0.0001f, 1.0f, "%.4f", ImGuiSliderFlags_Logarithmic);
+                const char* evaluators[] = { "Bernstein", "Forward differencing", "SIMD batch", "Adaptive" };
+                ImGui::Combo("Evaluator", &curveEvaluator, evaluators, IM_ARRAYSIZE(evaluators));
+                if (curveEvaluator == static_cast<int>(CurveEvaluator::SimdBatch)) {
+                    // umoznuje snizit uroven SIMD pro porovnani rychlosti
+                    int simdLevel = static_cast<int>(bezierCurveBatchLevel());
+                    const char* simdLevels[] = { "Scalar", "SSE2", "AVX2" };
+                    int detected = static_cast<int>(detectSimdLevel());
+                    if (ImGui::Combo("Instructions", &simdLevel, simdLevels, detected + 1)) {
+                        bezierCurveBatchLevel() = static_cast<SimdLevel>(simdLevel);
+                    }
+                }
+                if (curveEvaluator == static_cast<int>(CurveEvaluator::ForwardDifference)) {
+                    // 0 = bez prepocitani
+                    ImGui::SliderInt("Re-anchor every", &reanchorInterval, 0, 4096);
+                }
+                if (curveEvaluator == static_cast<int>(CurveEvaluator::Adaptive)) {
+                    ImGui::SliderFloat("Tolerance (px)", &tolerancePx, 0.05f, 10.0f, "%.2f", ImGuiSliderFlags_Logarithmic);
+                }
                 if(ImGui::CollapsingHeader("Points")){
                     for(int i = 0; i < 4; i++){
                         if(ImGui::CollapsingHeader(("Point " + std::to_string(i)).c_str())){
@@ -208,9 +434,46 @@ int main()
             // umoznuje ovladani jednotlivych bodu plochy v 3d
             if (!is2DMode && ImGui::CollapsingHeader("3d bezier surfaces")) {
                 ImGui::SliderFloat("Step", &step3d, 0.01f, 1.0f, "%.3f");
+                ImGui::Checkbox("Show surface mesh", &showSurfaceMesh);
+                const char* surfaceBackends[] = { "CPU", "Vertex shader", "Tessellation shader", "Compute shader", "CPU (GEMM)" };
+                if (ImGui::BeginCombo("Evaluation", surfaceBackends[surfaceBackend])) {
+                    for (int i = 0; i < IM_ARRAYSIZE(surfaceBackends); ++i) {
+                        ImGui::BeginDisabled(!surfaceBackendSupported[i]);
+                        if (ImGui::Selectable(surfaceBackends[i], surfaceBackend == i)) {
+                            selectSurfaceBackend(i);
+                        }
+                        ImGui::EndDisabled();
+                    }
+                    ImGui::EndCombo();
+                }
+                if (surfaceBackend == static_cast<int>(SurfaceBackend::Cpu) ||
+                    surfaceBackend == static_cast<int>(SurfaceBackend::CpuGemm)) {
+                    ImGui::Checkbox("Show sample markers", &showSampleMarkers);
+                }
+                if (surfaceBackend == static_cast<int>(SurfaceBackend::Tessellation)) {
+                    ImGui::SliderFloat("Pixels per segment", &tessPixelsPerSegment, 1.0f, 64.0f, "%.1f", ImGuiSliderFlags_Logarithmic);
+                }
                 ImGui::Text("Selected row: = %d", selectedRow);
                 ImGui::Text("Selected column: = %d", selectedCol);
             }
+            if (ImGui::CollapsingHeader("GPU profiler")) {
+                drawGpuProfiler();
+            }
+            if (ImGui::CollapsingHeader("Frame statistics")) {
+                drawFrameStats(frameStats, statsPath);
+            }
+            if (ImGui::CollapsingHeader("GL counters")) {
+                drawGlCounters();
+            }
+            if (ImGui::CollapsingHeader("CPU profiler")) {
+                bool recordZones = cpuProfilerEnabled();
+                if (ImGui::Checkbox("Record CPU zones", &recordZones)) {
+                    setCpuProfilerEnabled(recordZones);
+                }
+                if (ImGui::Button(("Write " + tracePath + " (F12)").c_str())) {
+                    writeCpuTrace(tracePath);
+                }
+            }
             ImGui::Text("Application average \n %.3f ms/frame \n (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
             
             ImGui::End();
@@ -218,13 +481,18 @@ int main()
 
         ImGui::Render();
         glViewport(0, 0, width, height);
+        beginGpuPass(GpuPass::Frame);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         camera.Inputs(window);
 
         if (is2DMode) {
             // nastavuje kameru pro 2d zobrazeni krivky
-            camera.Matrix(45.0f,0.1f,100.f, setUpShader[0],"camMatrix", is2DMode);
-            render2DBezierCurve(controlPoints2d, step2d, setup2d[0], setup2d[1], setup2d[2], setup2d[3], setup2d[4], setup2d[5], setup2d[6]);
+            camera.UpdateMatrix(45.0f,0.1f,100.f, is2DMode);
+            // tolerance v pixelech prevedena do souradnic krivky podle aktualni kamery
+            float tolerance = pixelToleranceToWorld(camera.GetMatrix(45.0f, 0.1f, 100.f, is2DMode), width, height, tolerancePx);
+            updateCurveCache(curveCache, controlPoints2d, step2d,
+                             static_cast<CurveEvaluator>(curveEvaluator), reanchorInterval, tolerance);
+            render2DBezierCurve(curveCache, setUpShader, curveStream, setup2d[0], setup2d[1], setup2d[2]);
         } else {
             // pro manipulaci s kontrolnímy body ve 3d
             bool ctrlPressed = glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS;
@@ -264,15 +532,71 @@ int main()
                 }
             }
             // naciteni kamery pro 3d zobrazeni plochy
-            camera.Matrix(45.0f,0.1f,200.f, setUpShader[0],"camMatrix", is2DMode);
-            render3DBezierSurface(controlPoints3d,setUpShader[0],cubeBuffers[0],cubeIndices.size(),step3d);
+            camera.UpdateMatrix(45.0f,0.1f,200.f, is2DMode);
+            if (surfaceBackend == static_cast<int>(SurfaceBackend::Tessellation) && tessellationSupported) {
+                render3DBezierSurfaceTessellated(surfaceTessellationPatch, controlPoints3d, setUpShader, cubeBuffers[0],
+                                                 cubeBuffers[3], cubeIndices.size(), tessSurfaceShader, width, height,
+                                                 tessPixelsPerSegment, showSurfaceMesh);
+            } else if (surfaceBackend == static_cast<int>(SurfaceBackend::Compute) && computeSupported) {
+                render3DBezierSurfaceCompute(surfaceComputeBatch, controlPoints3d, step3d, setUpShader, cubeBuffers[0],
+                                             cubeBuffers[3], cubeIndices.size(), computeSurfaceShader, surfaceShader,
+                                             showSurfaceMesh);
+            } else if (surfaceBackend == static_cast<int>(SurfaceBackend::VertexShader)) {
+                render3DBezierSurfaceGpu(surfaceGpuGrid, controlPoints3d, step3d, setUpShader, cubeBuffers[0], cubeBuffers[3],
+                                         cubeIndices.size(), gpuSurfaceShader, showSurfaceMesh);
+            } else {
+                updateSurfaceCache(surfaceCache, controlPoints3d, step3d,
+                                   surfaceBackend == static_cast<int>(SurfaceBackend::CpuGemm));
+                render3DBezierSurface(surfaceCache,setUpShader,cubeBuffers[0],cubeBuffers[3],cubeIndices.size(),
+                                      surfaceShader, surfaceMesh, showSurfaceMesh, showSampleMarkers);
+            }
         }
 
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        glfwSwapBuffers(window);
+        if (headless.enabled) {
+            // bez ImGui a bez prohozeni bufferu, snimek zustava ve FBO
+            endGpuPass(GpuPass::Frame);
+            captureFrame(frameCapture);
+            endFrameStatsSubmit(frameStats);
+            headlessFrameRendered(scenario);
+            continue;
+        }
+        {
+            CPU_ZONE("Render UI");
+            beginGpuPass(GpuPass::ImGui);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            endGpuPass(GpuPass::ImGui);
+        }
+        endGpuPass(GpuPass::Frame);
+        captureFrame(frameCapture);
+        // ImGui meni stav OpenGL mimo cache vazeb
+        resetGlStateCache();
+        endFrameStatsSubmit(frameStats);
+        redrawFrameFinished();
+        {
+            CPU_ZONE("glfwSwapBuffers");
+            glfwSwapBuffers(window);
+        }
+    }
+
+    if (headless.enabled) {
+        glFinish();
+        double elapsed = (glfwGetTime() - headlessStart) * 1000.0;
+        std::cout << "Rendered " << scenario.framesRendered << " frames in " << elapsed << " ms ("
+                  << elapsed / std::max(1, scenario.framesRendered) << " ms/frame)\n";
+        printFrameStatsSummary(frameStats);
+        printGlCounters();
+        destroyHeadlessTarget(headlessTarget);
+    }
+    stopFrameCapture(frameCapture);
+    if (!headless.tracePath.empty()) {
+        writeCpuTrace(tracePath);
+    }
+    if (!headless.statsPath.empty()) {
+        writeFrameStatsCsv(frameStats, statsPath);
     }
 
     // Konec
+    destroyStreamBuffer(curveStream);
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -0,0 +1,85 @@
+#pragma once
+#include <GLFW/glfw3.h>
+#include <algorithm>
+
+/*
+ vykreslovani na vyzadani: kdyz se nic nedeje, hlavni smycka spi v glfwWaitEventsTimeout misto prekreslovani
+ - kazda udalost okna (klavesnice, mys, zmena okna) oznaci nekolik snimku k prekresleni, aby ImGui
+   stihlo dokoncit zmeny vzhledu (najeti mysi, rozbaleni menu)
+ - drzena klavesa nebo tlacitko mysi (pohyb kamery, bodu) vykresluje neustale, dokud se nepusti
+ - zmena dat mimo udalosti se oznaci markRedraw
+ - nepretrzity rezim (onDemand = false, --continuous) kresli porad, napr. pro mereni vykonu
+*/
+
+// kolik snimku se vykresli po kazde udalosti
+const int RedrawSettleFrames = 3;
+// jak dlouho se nejvic ceka na udalost (s)
+const double RedrawIdleTimeout = 0.5;
+
+struct RedrawScheduler
+{
+    bool onDemand = true;
+    int pendingFrames = RedrawSettleFrames;
+    // pocet drzenych klaves a tlacitek mysi
+    int heldInputs = 0;
+};
+
+RedrawScheduler& redrawScheduler()
+{
+    static RedrawScheduler scheduler;
+    return scheduler;
+}
+
+void markRedraw(int frames = RedrawSettleFrames)
+{
+    RedrawScheduler& scheduler = redrawScheduler();
+    scheduler.pendingFrames = std::max(scheduler.pendingFrames, frames);
+}
+
+void trackHeldInput(int action)
+{
+    RedrawScheduler& scheduler = redrawScheduler();
+    if (action == GLFW_PRESS) {
+        scheduler.heldInputs++;
+    } else if (action == GLFW_RELEASE) {
+        scheduler.heldInputs = std::max(0, scheduler.heldInputs - 1);
+    }
+    markRedraw();
+}
+
+// musi se zavolat pred ImGui_ImplGlfw_InitForOpenGL, ImGui si tyto callbacky retezi za svoje
+void installRedrawCallbacks(GLFWwindow* window)
+{
+    glfwSetKeyCallback(window, [](GLFWwindow*, int, int, int action, int) { trackHeldInput(action); });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow*, int, int action, int) { trackHeldInput(action); });
+    glfwSetCursorPosCallback(window, [](GLFWwindow*, double, double) { markRedraw(); });
+    glfwSetScrollCallback(window, [](GLFWwindow*, double, double) { markRedraw(); });
+    glfwSetCharCallback(window, [](GLFWwindow*, unsigned int) { markRedraw(); });
+    glfwSetWindowSizeCallback(window, [](GLFWwindow*, int, int) { markRedraw(); });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow*) { markRedraw(); });
+    glfwSetWindowFocusCallback(window, [](GLFWwindow*, int) {
+        // uvolneni klaves mimo okno se nedorucuje, pocitadlo se radeji vynuluje
+        redrawScheduler().heldInputs = 0;
+        markRedraw();
+    });
+}
+
+// vykreslit dalsi snimek? (force = nahravani apod., kdy je potreba kazdy snimek)
+bool redrawNeeded(bool force)
+{
+    const RedrawScheduler& scheduler = redrawScheduler();
+    return force || !scheduler.onDemand || scheduler.heldInputs > 0 || scheduler.pendingFrames > 0;
+}
+
+// ceka na udalost; jeji callback pripadne oznaci snimek k prekresleni
+void waitForRedraw()
+{
+    glfwWaitEventsTimeout(RedrawIdleTimeout);
+}
+
+// po vykresleni snimku
+void redrawFrameFinished()
+{
+    RedrawScheduler& scheduler = redrawScheduler();
+    scheduler.pendingFrames = std::max(0, scheduler.pendingFrames - 1);
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "glad.h"
+#include "glState.h"
+#include "glm.hpp"
+#include "gtc/type_ptr.hpp"
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/*
+ slinkovany shader program s mapou aktivnich uniformu, atributu a uniform bloku
+ - vsechny lokace se zjisti jednou po slinkovani, pri vykreslovani se uz nevola glGetUniformLocation
+ - settery podle jmena hledaji jen v teto mape, settery podle lokace nehledaji vubec
+ - neexistujici (napr. prekladacem odstranena) uniforma ma lokaci -1 a zapis do ni se ignoruje
+ - pred kazdy shader se vlozi spolecny kod (shaderCommonSource), cisla radku v chybach zustavaji podle souboru
+*/
+
+// vazebni body sdilenych uniform bufferu
+const unsigned int CameraUniformBinding = 1;
+
+// spolecny kod shaderu (shaders/bezier_common.glsl), nastavi se pred vytvorenim prvniho programu
+std::string& shaderCommonSource()
+{
+    static std::string source;
+    return source;
+}
+
+class ShaderProgram
+{
+    public:
+    unsigned int ID = 0;
+
+    ShaderProgram() = default;
+
+    // prelozi a slinkuje shadery zadane jako (typ, zdrojovy kod)
+    ShaderProgram(std::initializer_list<std::pair<GLenum, const char*>> stages)
+    {
+        ID = glCreateProgram();
+        unsigned int shaders[6];
+        int shaderCount = 0;
+        for (const auto& stage : stages) {
+            unsigned int shader = glCreateShader(stage.first);
+            std::string source = WithCommonSource(stage.second);
+            const char* sourceCode = source.c_str();
+            glShaderSource(shader, 1, &sourceCode, NULL);
+            glCompileShader(shader);
+            CheckStatus(shader, false);
+            glAttachShader(ID, shader);
+            shaders[shaderCount++] = shader;
+        }
+        glLinkProgram(ID);
+        CheckStatus(ID, true);
+        for (int i = 0; i < shaderCount; ++i) {
+            glDeleteShader(shaders[i]);
+        }
+        Reflect();
+    }
+
+    void Use() const
+    {
+        useProgramCached(ID);
+    }
+
+    GLint UniformLocation(const std::string& name) const
+    {
+        auto it = uniforms.find(name);
+        return it == uniforms.end() ? -1 : it->second;
+    }
+
+    GLint AttributeLocation(const std::string& name) const
+    {
+        auto it = attributes.find(name);
+        return it == attributes.end() ? -1 : it->second;
+    }
+
+    // priradi uniform blok k vazebnemu bodu, pokud ho program pouziva
+    void BindUniformBlock(const std::string& name, unsigned int binding) const
+    {
+        auto it = uniformBlocks.find(name);
+        if (it != uniformBlocks.end()) {
+            glUniformBlockBinding(ID, it->second, binding);
+        }
+    }
+
+    // settery zapisuji do programu ID (GL 3.3 nema glProgramUniform), program musi byt pouzivany
+    void SetInt(GLint location, int value) const { glUniform1i(location, value); }
+    void SetFloat(GLint location, float value) const { glUniform1f(location, value); }
+    void SetVec2(GLint location, const glm::vec2& value) const { glUniform2f(location, value.x, value.y); }
+    void SetVec3(GLint location, const glm::vec3& value) const { glUniform3f(location, value.x, value.y, value.z); }
+    void SetMat4(GLint location, const glm::mat4& value) const
+    {
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+
+    void SetInt(const std::string& name, int value) const { SetInt(UniformLocation(name), value); }
+    void SetFloat(const std::string& name, float value) const { SetFloat(UniformLocation(name), value); }
+    void SetVec2(const std::string& name, const glm::vec2& value) const { SetVec2(UniformLocation(name), value); }
+    void SetVec3(const std::string& name, const glm::vec3& value) const { SetVec3(UniformLocation(name), value); }
+    void SetMat4(const std::string& name, const glm::mat4& value) const { SetMat4(UniformLocation(name), value); }
+
+    private:
+    std::unordered_map<std::string, GLint> uniforms;
+    std::unordered_map<std::string, GLint> attributes;
+    std::unordered_map<std::string, GLuint> uniformBlocks;
+
+    // vypise chybu prekladu shaderu nebo slinkovani programu
+    static void CheckStatus(unsigned int object, bool isProgram)
+    {
+        int success = 0;
+        char log[1024];
+        if (isProgram) {
+            glGetProgramiv(object, GL_LINK_STATUS, &success);
+            if (!success) {
+                glGetProgramInfoLog(object, sizeof(log), NULL, log);
+                std::cerr << "Shader program link failed:\n" << log << "\n";
+            }
+        } else {
+            glGetShaderiv(object, GL_COMPILE_STATUS, &success);
+            if (!success) {
+                glGetShaderInfoLog(object, sizeof(log), NULL, log);
+                std::cerr << "Shader compilation failed:\n" << log << "\n";
+            }
+        }
+    }
+
+    // vlozi spolecny kod za uvodni radky #version a #extension, ktere musi byt na zacatku shaderu
+    static std::string WithCommonSource(const char* code)
+    {
+        std::string source(code);
+        size_t headerEnd = 0;
+        int headerLines = 0;
+        int lines = 0;
+        size_t lineStart = 0;
+        while (lineStart < source.size()) {
+            size_t lineEnd = source.find('\n', lineStart);
+            lineEnd = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+            std::string line = source.substr(lineStart, lineEnd - lineStart);
+            size_t first = line.find_first_not_of(" \t\r\n");
+            ++lines;
+            if (first != std::string::npos && (line.compare(first, 8, "#version") == 0 || line.compare(first, 10, "#extension") == 0)) {
+                headerEnd = lineEnd;
+                headerLines = lines;
+            } else if (first != std::string::npos && line.compare(first, 2, "//") != 0) {
+                break;
+            }
+            lineStart = lineEnd;
+        }
+        return source.substr(0, headerEnd) + shaderCommonSource() + "\n#line " + std::to_string(headerLines + 1) + "\n" +
+               source.substr(headerEnd);
+    }
+
+    // jmena pole jsou ve tvaru "name[0]", ulozi se i bez indexu
+    static std::string BaseName(const char* name)
+    {
+        std::string result(name);
+        size_t bracket = result.find('[');
+        return bracket == std::string::npos ? result : result.substr(0, bracket);
+    }
+
+    void Reflect()
+    {
+        char name[256];
+        GLint count = 0;
+        GLint size = 0;
+        GLenum type = 0;
+
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            glGetActiveUniform(ID, i, sizeof(name), NULL, &size, &type, name);
+            // uniformy v blocich nemaji lokaci, nastavuji se pres uniform buffer
+            GLint location = glGetUniformLocation(ID, name);
+            if (location >= 0) {
+                uniforms[name] = location;
+                uniforms[BaseName(name)] = location;
+            }
+        }
+
+        glGetProgramiv(ID, GL_ACTIVE_ATTRIBUTES, &count);
+        for (GLint i = 0; i < count; ++i) {
+            glGetActiveAttrib(ID, i, sizeof(name), NULL, &size, &type, name);
+            attributes[name] = glGetAttribLocation(ID, name);
+        }
+
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            glGetActiveUniformBlockName(ID, i, sizeof(name), NULL, name);
+            uniformBlocks[name] = i;
+        }
+        // matice kamery jsou ve sdilenem bufferu (viz Camera::UpdateMatrix)
+        BindUniformBlock("CameraMatrices", CameraUniformBinding);
+    }
+};
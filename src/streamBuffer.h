@@ -0,0 +1,131 @@
+#pragma once
+#include "glad.h"
+#include "glState.h"
+#include <algorithm>
+
+/*
+ kruhovy buffer pro vrcholy, ktere se meni po snimcich (napr. body krivky)
+ - buffer ma StreamBufferFrames oblasti, kazda zmena se zapise do dalsi oblasti, takze CPU nikdy
+   nepise do dat, ktera GPU jeste cte; oblast se znovu pouzije az po signalu jejiho fence
+ - fence se vlozi az pri prechodu na dalsi oblast (pri dalsim zapisu), takze pokryje vsechna kresleni
+   z opoustene oblasti a snimky beze zmeny zadny fence nestoji
+ - s ARB_buffer_storage je buffer namapovany trvale (persistent + coherent) a tessellator pise primo do nej,
+   bez mezilehlych vektoru a bez realokace bufferu v ovladaci
+ - bez rozsireni se oblast mapuje glMapBufferRange s GL_MAP_UNSYNCHRONIZED_BIT, synchronizaci dela fence
+*/
+
+const int StreamBufferFrames = 3;
+
+struct StreamBuffer
+{
+    unsigned int buffer = 0;
+    // velikost vrcholu v bajtech a pocet vrcholu v jedne oblasti
+    int vertexSize = 0;
+    int capacity = 0;
+    int region = 0;
+    GLsync fences[StreamBufferFrames] = {};
+    // trvale namapovany zacatek bufferu (nullptr bez ARB_buffer_storage)
+    char* persistent = nullptr;
+    // buffer byl znovu vytvoren, VAO ktera ho pouzivaji je potreba znovu nastavit (uzivatel flag nuluje)
+    bool recreated = false;
+};
+
+// pocka, az GPU docte oblast region
+void waitStreamBufferRegion(StreamBuffer& stream, int region)
+{
+    GLsync& fence = stream.fences[region];
+    if (!fence) {
+        return;
+    }
+    while (true) {
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED) {
+            break;
+        }
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void destroyStreamBuffer(StreamBuffer& stream)
+{
+    for (int i = 0; i < StreamBufferFrames; ++i) {
+        if (stream.fences[i]) {
+            glDeleteSync(stream.fences[i]);
+            stream.fences[i] = nullptr;
+        }
+    }
+    if (stream.buffer) {
+        // trvale namapovany buffer se pri smazani odmapuje sam
+        deleteBufferCached(stream.buffer);
+        stream.buffer = 0;
+    }
+    stream.persistent = nullptr;
+}
+
+// vytvori (nebo pri zvetseni znovu vytvori) buffer pro StreamBufferFrames oblasti po capacity vrcholech
+void createStreamBuffer(StreamBuffer& stream, int vertexSize, int capacity)
+{
+    destroyStreamBuffer(stream);
+    stream.vertexSize = vertexSize;
+    stream.capacity = capacity;
+    stream.region = 0;
+    stream.recreated = true;
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(vertexSize) * capacity * StreamBufferFrames;
+    glGenBuffers(1, &stream.buffer);
+    bindBufferCached(GL_ARRAY_BUFFER, stream.buffer);
+    if (GLAD_GL_ARB_buffer_storage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+        stream.persistent = static_cast<char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+}
+
+// prvni vrchol aktualni oblasti (pro first v glDrawArrays)
+int streamBufferFirst(const StreamBuffer& stream)
+{
+    return stream.region * stream.capacity;
+}
+
+// oznaci konec kresleni z aktualni oblasti, oblast se prepise az GPU dokonci vsechna kresleni z ni
+void retireStreamBufferRegion(StreamBuffer& stream)
+{
+    GLsync& fence = stream.fences[stream.region];
+    if (fence) {
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+// prepne na dalsi oblast a vrati ukazatel, kam se zapise count vrcholu
+// pokud se buffer musel zvetsit, zmeni se stream.buffer a nastavi se stream.recreated
+void* beginStreamBufferWrite(StreamBuffer& stream, int count)
+{
+    if (count > stream.capacity) {
+        createStreamBuffer(stream, stream.vertexSize, std::max(count, stream.capacity * 2));
+    } else {
+        retireStreamBufferRegion(stream);
+        stream.region = (stream.region + 1) % StreamBufferFrames;
+    }
+    waitStreamBufferRegion(stream, stream.region);
+
+    GLintptr offset = static_cast<GLintptr>(streamBufferFirst(stream)) * stream.vertexSize;
+    if (stream.persistent) {
+        return stream.persistent + offset;
+    }
+    bindBufferCached(GL_ARRAY_BUFFER, stream.buffer);
+    return glMapBufferRange(GL_ARRAY_BUFFER, offset, static_cast<GLsizeiptr>(count) * stream.vertexSize,
+                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+}
+
+void endStreamBufferWrite(StreamBuffer& stream)
+{
+    // koherentni mapovani neni potreba nijak ukoncovat
+    if (!stream.persistent) {
+        bindBufferCached(GL_ARRAY_BUFFER, stream.buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+}
@@ -0,0 +1,92 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "bezierSurface.h"
+
+/*
+ maticovy vypocet plochy (evaluateSurfaceGridGemm, evaluateSurfacePatchesGemm) proti skalarnimu
+ calculateBezierSurfacePoints, nepotrebuje OpenGL kontext; vraci 0, pokud vse sedi
+*/
+
+const float Tolerance = 1e-4f;
+
+// testovaci plocha, seed meni tvar
+void makeTestPatch(glm::vec3 controlPoints[4][4], float seed)
+{
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            controlPoints[i][j] = glm::vec3(i * 1.5f - 2.0f, std::sin(i * 1.3f + j * 0.7f + seed), j * 1.25f - 2.0f + seed);
+        }
+    }
+}
+
+// jedna plocha: body i normaly
+bool checkSingleGrid(float step)
+{
+    glm::vec3 controlPoints[4][4];
+    makeTestPatch(controlPoints, 0.0f);
+    std::vector<glm::vec3> points, normals, gemmPoints, gemmNormals;
+    std::vector<float> scratch;
+    int resolution = calculateBezierSurfacePoints(controlPoints, step, points, &normals);
+    evaluateSurfaceGridGemm(controlPoints, makeSurfaceGridBasis(resolution, resolution), scratch, gemmPoints, &gemmNormals);
+
+    float deviation = 0.0f;
+    for (size_t k = 0; k < points.size(); ++k) {
+        deviation = std::max(deviation, glm::length(points[k] - gemmPoints[k]));
+        deviation = std::max(deviation, glm::length(normals[k] - gemmNormals[k]));
+    }
+    if (!(deviation <= Tolerance)) {
+        std::cerr << "GEMM grid with step " << step << " deviates by " << deviation << "\n";
+        return false;
+    }
+    return true;
+}
+
+// vic ploch najednou, nu != nv (sloupce, ktere nejsou nasobkem 4)
+bool checkPatchBatch(int nu, int nv)
+{
+    const int patchCount = 3;
+    glm::vec3 patches[patchCount][4][4];
+    for (int p = 0; p < patchCount; ++p) {
+        makeTestPatch(patches[p], 0.9f * p);
+    }
+    size_t count = static_cast<size_t>(nu) * nv;
+    std::vector<float> x(count * patchCount), y(count * patchCount), z(count * patchCount);
+    std::vector<float> scratch;
+    evaluateSurfacePatchesGemm(patches, patchCount, makeSurfaceGridBasis(nu, nv), scratch, x.data(), y.data(), z.data());
+
+    const BernsteinBasisTable& Bu = bernsteinBasisTable(3, nu);
+    const BernsteinBasisTable& Bv = bernsteinBasisTable(3, nv);
+    float deviation = 0.0f;
+    for (int p = 0; p < patchCount; ++p) {
+        for (int u = 0; u < nu; ++u) {
+            for (int v = 0; v < nv; ++v) {
+                glm::vec3 expected(0.0f);
+                for (int i = 0; i < 4; ++i) {
+                    for (int j = 0; j < 4; ++j) {
+                        expected += Bu.row(u)[i] * Bv.row(v)[j] * patches[p][i][j];
+                    }
+                }
+                size_t k = p * count + static_cast<size_t>(u) * nv + v;
+                deviation = std::max(deviation, glm::length(expected - glm::vec3(x[k], y[k], z[k])));
+            }
+        }
+    }
+    if (!(deviation <= Tolerance)) {
+        std::cerr << "GEMM batch of " << patchCount << " patches " << nu << " x " << nv << " deviates by " << deviation << "\n";
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    bool ok = true;
+    for (float step : { 0.5f, 0.1f, 0.013f }) {
+        ok = checkSingleGrid(step) && ok;
+    }
+    ok = checkPatchBatch(7, 13) && ok;
+    ok = checkPatchBatch(70, 66) && ok;
+    std::cout << (ok ? "GEMM surface evaluation matches the scalar grid\n" : "GEMM surface evaluation FAILED\n");
+    return ok ? 0 : 1;
+}